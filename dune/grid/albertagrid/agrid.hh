@@ -29,6 +29,7 @@
 #include <dune/grid/common/grid.hh>
 #include <dune/grid/common/gridfactory.hh>
 #include <dune/grid/common/adaptcallback.hh>
+#include <dune/grid/common/instrumentation.hh>
 #include <dune/grid/common/sizecache.hh>
 
 //- Local includes
@@ -430,6 +431,21 @@ namespace Dune
     //! clean up some markers
     void postAdapt();
 
+    /** \brief enable or disable iteration over a flat leaf snapshot
+     *
+     *  If enabled, the leaf elements are collected into a contiguous array
+     *  once after each adaptation and the leaf iterators of all codimensions
+     *  walk over this array instead of traversing the element tree.  This
+     *  pays off if the leaf grid is traversed many times between two
+     *  adaptations, at the cost of keeping the element information of all
+     *  leaf elements and their fathers in memory.  The snapshot is disabled
+     *  by default.
+     *
+     *  \note The snapshot is rebuilt by this method and by adapt(), which
+     *        invalidates all leaf iterators.
+     */
+    void setLeafSnapshot ( bool enable );
+
     /** \brief return reference to collective communication, if MPI found
      * this is specialisation for MPI */
     const CollectiveCommunication &comm () const
@@ -545,6 +561,12 @@ namespace Dune
     // extra method because of Reihenfolge
     void calcExtras();
 
+    // leaf elements in the order of the leaf iterator, null if the snapshot is disabled
+    const std::vector< ElementInfo > *leafSnapshot () const;
+
+    // collect the leaf elements into the snapshot, if it is enabled
+    void buildLeafSnapshot ();
+
   private:
     // delete mesh and all vectors
     void removeMesh();
@@ -645,6 +667,10 @@ namespace Dune
     Alberta::CoordCache< dimension > coordCache_;
 #endif
 
+    // flat array of the leaf elements, built after each adaptation
+    bool leafSnapshotEnabled_;
+    std::vector< ElementInfo > leafSnapshot_;
+
     // current state of adaptation
     AdaptationState adaptationState_;
   };
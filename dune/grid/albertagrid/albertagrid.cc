@@ -47,7 +47,8 @@ namespace Dune
       leafIndexSet_( 0 ),
       sizeCache_( *this ),
       leafMarkerVector_( dofNumbering_ ),
-      levelMarkerVector_( (size_t)MAXL, MarkerVector( dofNumbering_ ) )
+      levelMarkerVector_( (size_t)MAXL, MarkerVector( dofNumbering_ ) ),
+      leafSnapshotEnabled_( false )
   {
     checkAlbertaDimensions< dim, dimworld>();
   }
@@ -67,7 +68,8 @@ namespace Dune
       leafIndexSet_ ( 0 ),
       sizeCache_( *this ),
       leafMarkerVector_( dofNumbering_ ),
-      levelMarkerVector_( (size_t)MAXL, MarkerVector( dofNumbering_ ) )
+      levelMarkerVector_( (size_t)MAXL, MarkerVector( dofNumbering_ ) ),
+      leafSnapshotEnabled_( false )
   {
     checkAlbertaDimensions< dim, dimworld >();
 
@@ -95,7 +97,8 @@ namespace Dune
       leafIndexSet_ ( 0 ),
       sizeCache_( *this ),
       leafMarkerVector_( dofNumbering_ ),
-      levelMarkerVector_( (size_t)MAXL, MarkerVector( dofNumbering_ ) )
+      levelMarkerVector_( (size_t)MAXL, MarkerVector( dofNumbering_ ) ),
+      leafSnapshotEnabled_( false )
   {
     checkAlbertaDimensions< dim, dimworld >();
 
@@ -127,7 +130,8 @@ namespace Dune
       leafIndexSet_ ( 0 ),
       sizeCache_( *this ),
       leafMarkerVector_( dofNumbering_ ),
-      levelMarkerVector_( (size_t)MAXL, MarkerVector( dofNumbering_ ) )
+      levelMarkerVector_( (size_t)MAXL, MarkerVector( dofNumbering_ ) ),
+      leafSnapshotEnabled_( false )
   {
     checkAlbertaDimensions< dim, dimworld >();
 
@@ -176,6 +180,8 @@ namespace Dune
       delete leafIndexSet_;
     leafIndexSet_ = 0;
 
+    leafSnapshot_.clear();
+
     // release dof vectors
     hIndexSet_.release();
     levelProvider_.release();
@@ -412,9 +418,14 @@ namespace Dune
   template< int dim, int dimworld >
   inline bool AlbertaGrid< dim, dimworld >::adapt ()
   {
+    DUNE_GRID_INSTRUMENT_REGION( region, "AlbertaGrid::adapt" );
+
     // this is already done in postAdapt
     //levelProvider_.markAllOld();
 
+    // the snapshot refers to the old leaf elements
+    leafSnapshot_.clear();
+
     // adapt mesh
     hIndexSet_.preAdapt();
     const bool refined = mesh_.refine();
@@ -424,6 +435,8 @@ namespace Dune
 
     if( refined || coarsened )
       calcExtras();
+    else
+      buildLeafSnapshot();
 
     // return true if elements were created
     return refined;
@@ -463,6 +476,41 @@ namespace Dune
   }
 
 
+  template< int dim, int dimworld >
+  inline void AlbertaGrid< dim, dimworld >::setLeafSnapshot ( bool enable )
+  {
+    leafSnapshotEnabled_ = enable;
+    buildLeafSnapshot();
+  }
+
+
+  template< int dim, int dimworld >
+  inline const std::vector< typename AlbertaGrid< dim, dimworld >::ElementInfo > *
+  AlbertaGrid< dim, dimworld >::leafSnapshot () const
+  {
+    // there is at least one leaf element, so an empty snapshot has not been built
+    return (leafSnapshot_.empty() ? nullptr : &leafSnapshot_);
+  }
+
+
+  template< int dim, int dimworld >
+  inline void AlbertaGrid< dim, dimworld >::buildLeafSnapshot ()
+  {
+    leafSnapshot_.clear();
+    if( !leafSnapshotEnabled_ )
+    {
+      std::vector< ElementInfo >().swap( leafSnapshot_ );
+      return;
+    }
+
+    leafSnapshot_.reserve( mesh_.size( 0 ) );
+    auto collect = [ this ] ( const ElementInfo &elementInfo ) { leafSnapshot_.push_back( elementInfo ); };
+    const typename MeshPointer::MacroIterator end = mesh_.end();
+    for( typename MeshPointer::MacroIterator it = mesh_.begin(); it != end; ++it )
+      (*it).leafTraverse( collect );
+  }
+
+
   template< int dim, int dimworld >
   inline const Alberta::GlobalVector &
   AlbertaGrid< dim, dimworld >
@@ -535,6 +583,7 @@ namespace Dune
     if( leafIndexSet_ == 0 )
     {
       leafIndexSet_ = new typename GridFamily::LeafIndexSetImp( dofNumbering_ );
+      leafIndexSet_->enableIncrementalUpdate();
       leafIndexSet_->update( leafbegin< 0 >(), leafend< 0 >() );
     }
     return *leafIndexSet_;
@@ -555,9 +604,13 @@ namespace Dune
     // unset up2Dat status, if leafbegin is called then this status is updated
     leafMarkerVector_.clear();
 
+    // collect the new leaf elements before the leaf index set is updated
+    buildLeafSnapshot();
+
     sizeCache_.reset();
 
-    // update index sets (if they exist)
+    // update index sets (if they exist); the leaf index set has followed the
+    // adaptation and only needs to close the gaps left by coarsening
     if( leafIndexSet_ != 0 )
       leafIndexSet_->update( leafbegin< 0 >(), leafend< 0 >() );
     for( unsigned int level = 0; level < levelIndexVec_.size(); ++level )
@@ -141,6 +141,60 @@ namespace Dune
       macroData_.insertElement( array );
     }
 
+    /** \brief reserve memory for the macro grid
+     *
+     *  \param[in]  numVertices  number of vertices that will be inserted
+     *  \param[in]  numElements  number of elements that will be inserted
+     */
+    virtual void reserve ( std::size_t numVertices, std::size_t numElements )
+    {
+      macroData_.reserve( numVertices, numElements );
+    }
+
+    /** \brief insert several vertices into the macro grid
+     *
+     *  \param[in]  coordinates  world coordinates of all vertices, one vertex after the other
+     *  \param[in]  numVertices  number of vertices
+     */
+    virtual void insertVertices ( const ctype *coordinates, std::size_t numVertices )
+    {
+      WorldVector pos;
+      for( std::size_t i = 0; i < numVertices; ++i, coordinates += dimensionworld )
+      {
+        std::copy( coordinates, coordinates + dimensionworld, pos.begin() );
+        macroData_.insertVertex( pos );
+      }
+    }
+
+    // use default implementation from base class for elements of different types
+    using GridFactoryInterface< Grid >::insertElements;
+
+    /** \brief insert several elements of the same type into the macro grid
+     *
+     *  \param[in]  type         GeometryType of all elements
+     *  \param[in]  vertices     indices of the element vertices (in DUNE numbering), one element after the other
+     *  \param[in]  numElements  number of elements
+     */
+    virtual void insertElements ( const GeometryType &type, const unsigned int *vertices, std::size_t numElements )
+    {
+      if( (int)type.dim() != dimension )
+        DUNE_THROW( AlbertaError, "Inserting element of wrong dimension: " << type.dim() );
+      if( !type.isSimplex() )
+        DUNE_THROW( AlbertaError, "Alberta supports only simplices." );
+
+      int permutation[ numVertices ];
+      for( int i = 0; i < numVertices; ++i )
+        permutation[ i ] = numberingMap_.alberta2dune( dimension, i );
+
+      int array[ numVertices ];
+      for( std::size_t k = 0; k < numElements; ++k, vertices += numVertices )
+      {
+        for( int i = 0; i < numVertices; ++i )
+          array[ i ] = vertices[ permutation[ i ] ];
+        macroData_.insertElement( array );
+      }
+    }
+
     /** \brief mark a face as boundary (and assign a boundary id)
      *
      *  \internal
@@ -3,7 +3,10 @@
 #ifndef DUNE_ALBERTAGRIDINDEXSETS_HH
 #define DUNE_ALBERTAGRIDINDEXSETS_HH
 
+#include <algorithm>
 #include <array>
+#include <type_traits>
+#include <vector>
 
 #include <dune/common/hybridutilities.hh>
 #include <dune/common/stdstreams.hh>
@@ -18,6 +21,7 @@
 #include <dune/grid/albertagrid/dofvector.hh>
 #include <dune/grid/albertagrid/elementinfo.hh>
 #include <dune/grid/albertagrid/gridfamily.hh>
+#include <dune/grid/albertagrid/refinement.hh>
 
 #if HAVE_ALBERTA
 
@@ -327,6 +331,18 @@ namespace Dune
   // AlbertaGridIndexSet
   // -------------------
 
+  /** \brief level and leaf index set of AlbertaGrid
+   *
+   *  The indices are stored in ALBERTA DOF vectors, which grow with the mesh
+   *  and are kept across updates.  update() numbers the elements in the order
+   *  of the iterator range and all other entities in the order of their DOFs;
+   *  with OpenMP, the entities are collected in parallel.
+   *
+   *  After enableIncrementalUpdate(), the index set instead follows the
+   *  refinement and coarsening of the leaf elements during adaptation, and
+   *  update() only closes the gaps left by removed entities.  Only the indices
+   *  of entities above the new size are changed then.
+   */
   template< int dim, int dimworld >
   class AlbertaGridIndexSet
     : public IndexSet< AlbertaGrid< dim, dimworld >, AlbertaGridIndexSet< dim, dimworld >, int, std::array< GeometryType, 1 > >
@@ -349,24 +365,39 @@ namespace Dune
   private:
     typedef typename Grid::Traits Traits;
 
+    typedef Alberta::DofVectorPointer< IndexType > IndexVectorPointer;
+
+    template< int codim >
+    struct Fill;
+
     template< int codim >
-    struct Insert;
+    struct TrackLeaf;
 
   public:
     explicit AlbertaGridIndexSet ( const DofNumbering &dofNumbering )
-      : dofNumbering_( dofNumbering )
+      : dofNumbering_( dofNumbering ),
+        incremental_( false ),
+        numbered_( false )
     {
       for( int codim = 0; codim <= dimension; ++codim )
       {
-        indices_[ codim ] = 0;
+        indices_[ codim ].create( dofNumbering_.dofSpace( codim ), "Index set indices" );
+        indices_[ codim ].initialize( -1 );
+        size_[ codim ] = 0;
         geomTypes_[ codim ].push_back( GeometryTypes::simplex( dimension - codim ) );
       }
     }
 
+    AlbertaGridIndexSet ( const This & ) = delete;
+    This &operator= ( const This & ) = delete;
+
     ~AlbertaGridIndexSet ()
     {
       for( int codim = 0; codim <= dimension; ++codim )
-        delete[] indices_[ codim ];
+      {
+        indices_[ codim ].release();
+        counts_[ codim ].release();
+      }
     }
 
     template< class Entity >
@@ -378,7 +409,7 @@ namespace Dune
         = entity.impl();
       const Alberta::Element *element = entityImp.elementInfo().el();
 
-      const IndexType *const array = indices_[ codim ];
+      const IndexType *const array = (const IndexType *)indices_[ codim ];
       const IndexType subIndex = array[ dofNumbering_( element, codim, entityImp.subEntity() ) ];
 
       return (subIndex >= 0);
@@ -414,6 +445,30 @@ namespace Dune
       return subIndex( entityImp.elementInfo(), j, codim );
     }
 
+    //! return the indices of all sub entities of given codimension of an element
+    template< int cc >
+    std::enable_if_t< cc == 0, typename Base::SubIndices >
+    subIndices ( const typename Traits::template Codim< cc >::Entity &entity, unsigned int codim ) const
+    {
+      typedef AlbertaGridEntity< 0, dim, const Grid > EntityImp;
+      const EntityImp &entityImp = entity.impl();
+
+      // look up the ALBERTA element and the index array only once
+      const Alberta::Element *element = entityImp.elementInfo().el();
+      const IndexType *const array = (const IndexType *)indices_[ codim ];
+
+      typename Base::SubIndices subIndices;
+      const int numSubEntities = ReferenceElements< Alberta::Real, dimension >::simplex().size( codim );
+      subIndices.resize( numSubEntities );
+      for( int i = 0; i < numSubEntities; ++i )
+      {
+        const int j = entityImp.grid().generic2alberta( codim, i );
+        subIndices[ i ] = array[ dofNumbering_( element, codim, j ) ];
+        assert( (subIndices[ i ] >= 0) && (subIndices[ i ] < size( codim )) );
+      }
+      return subIndices;
+    }
+
     IndexType size ( const GeometryType &type ) const
     {
       return (type.isSimplex() ? size( dimension - type.dim() ) : 0);
@@ -437,29 +492,42 @@ namespace Dune
       return geomTypes_[ codim ];
     }
 
+    /** \brief number the entities of the given elements
+     *
+     *  With incremental update enabled, this only has to be called once for
+     *  the initial numbering.  Later calls just remove the gaps left by
+     *  coarsening.
+     */
     template< class Iterator >
     void update ( const Iterator &begin, const Iterator &end )
     {
-      for( int codim = 0; codim <= dimension; ++codim )
+      if( incremental_ && numbered_ )
       {
-        delete[] indices_[ codim ];
-
-        const unsigned int dofSize = dofNumbering_.size( codim );
-        indices_[ codim ] = new IndexType[ dofSize ];
-        for( unsigned int i = 0; i < dofSize; ++i )
-          indices_[ codim ][ i ] = -1;
-
-        size_[ codim ] = 0;
+        for( int codim = 0; codim <= dimension; ++codim )
+          compress( codim );
+        return;
       }
 
+      elements_.clear();
       for( Iterator it = begin; it != end; ++it )
-      {
-        const AlbertaGridEntity< 0, dim, const Grid > &entityImp
-          = it->impl();
-        const Alberta::Element *element = entityImp.elementInfo().el();
-        Hybrid::forEach( Std::make_index_sequence< dimension+1 >{},
-          [ & ]( auto i ){ Insert< i >::apply( element, *this ); } );
-      }
+        elements_.push_back( it->impl().elementInfo().el() );
+
+      Hybrid::forEach( Std::make_index_sequence< dimension+1 >{},
+        [ & ]( auto i ){ Fill< i >::apply( *this ); } );
+      numbered_ = true;
+    }
+
+    /** \brief follow the leaf elements through adaptation instead of renumbering in update
+     *
+     *  Must be called before the first update.  The index set then has to be
+     *  given the leaf elements in update.
+     */
+    void enableIncrementalUpdate ()
+    {
+      assert( !numbered_ );
+      Hybrid::forEach( Std::make_index_sequence< dimension+1 >{},
+        [ & ]( auto i ){ TrackLeaf< i >::setup( *this ); } );
+      incremental_ = true;
     }
 
   private:
@@ -477,47 +545,256 @@ namespace Dune
      */
     IndexType subIndex ( const Alberta::Element *element, int i, unsigned int codim ) const
     {
-      const IndexType *const array = indices_[ codim ];
+      const IndexType *const array = (const IndexType *)indices_[ codim ];
       const IndexType subIndex = array[ dofNumbering_( element, codim, i ) ];
       assert( (subIndex >= 0) && (subIndex < size( codim )) );
       return subIndex;
     }
 
+    // give an entity that entered the leaf an index, reusing freed ones
+    IndexType newIndex ( int codim )
+    {
+      std::vector< IndexType > &freeIndices = freeIndices_[ codim ];
+      if( freeIndices.empty() )
+        return size_[ codim ]++;
+      const IndexType index = freeIndices.back();
+      freeIndices.pop_back();
+      return index;
+    }
+
+    // move the indices above the new size into the gaps below it
+    void compress ( int codim )
+    {
+      std::vector< IndexType > &freeIndices = freeIndices_[ codim ];
+      if( freeIndices.empty() )
+        return;
+
+      const IndexType newSize = size_[ codim ] - IndexType( freeIndices.size() );
+      freeIndices.erase( std::remove_if( freeIndices.begin(), freeIndices.end(),
+                                         [ newSize ] ( IndexType index ) { return index >= newSize; } ),
+                         freeIndices.end() );
+
+      // only look at the DOFs in use, the others may hold stale values after DOF compression
+      auto move = [ &freeIndices, newSize ] ( IndexType &index )
+      {
+        if( index >= newSize )
+        {
+          index = freeIndices.back();
+          freeIndices.pop_back();
+        }
+      };
+      indices_[ codim ].forEach( move );
+      assert( freeIndices.empty() );
+      size_[ codim ] = newSize;
+    }
+
     // access to the dof vectors
     const DofNumbering &dofNumbering_;
 
-    // an array of indices for each codimension
-    IndexType *indices_[ dimension+1 ];
+    // the index of each entity for each codimension, -1 if the entity is not contained
+    IndexVectorPointer indices_[ dimension+1 ];
+
+    // with incremental update: the number of leaf elements containing each entity
+    IndexVectorPointer counts_[ dimension+1 ];
+
+    // with incremental update: indices freed during adaptation
+    std::vector< IndexType > freeIndices_[ dimension+1 ];
+
+    // the elements of the last update, kept to reuse the memory
+    std::vector< const Alberta::Element * > elements_;
 
     // the size of each codimension
     IndexType size_[ dimension+1 ];
 
+    // whether the index set follows the leaf through adaptation
+    bool incremental_;
+    // whether update has been called
+    bool numbered_;
+
     // all geometry types contained in the grid
     std::vector< GeometryType > geomTypes_[ dimension+1 ];
   };
 
 
 
-  // AlbertaGridIndexSet::Insert
-  // ---------------------------
+  // AlbertaGridIndexSet::Fill
+  // -------------------------
 
   template< int dim, int dimworld >
   template< int codim >
-  struct AlbertaGridIndexSet< dim, dimworld >::Insert
+  struct AlbertaGridIndexSet< dim, dimworld >::Fill
   {
-    static void apply ( const Alberta::Element *const element,
-                        AlbertaGridIndexSet< dim, dimworld > &indexSet )
+    static const int numSubEntities = Alberta::NumSubEntities< dim, codim >::value;
+
+    static void apply ( AlbertaGridIndexSet< dim, dimworld > &indexSet )
+    {
+      const std::vector< const Alberta::Element * > &elements = indexSet.elements_;
+      const long long numElements = elements.size();
+      const DofNumbering &dofNumbering = indexSet.dofNumbering_;
+      const int dofSize = dofNumbering.size( codim );
+
+      IndexType *const array = (IndexType *)indexSet.indices_[ codim ];
+      IndexType *const count = (indexSet.incremental_ ? (IndexType *)indexSet.counts_[ codim ] : nullptr);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for( int dof = 0; dof < dofSize; ++dof )
+      {
+        array[ dof ] = -1;
+        if( count )
+          count[ dof ] = 0;
+      }
+      indexSet.freeIndices_[ codim ].clear();
+
+      if( codim == 0 )
+      {
+        // the elements are numbered in the order they were given
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for( long long i = 0; i < numElements; ++i )
+        {
+          const int dof = dofNumbering( elements[ i ], 0, 0 );
+          array[ dof ] = IndexType( i );
+          if( count )
+            count[ dof ] = 1;
+        }
+        indexSet.size_[ codim ] = IndexType( numElements );
+        return;
+      }
+
+      // mark (or count) the entities of all elements, ...
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for( long long i = 0; i < numElements; ++i )
+      {
+        for( int j = 0; j < numSubEntities; ++j )
+        {
+          const int dof = dofNumbering( elements[ i ], codim, j );
+          if( count )
+          {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+            ++count[ dof ];
+          }
+          else
+          {
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+            array[ dof ] = 0;
+          }
+        }
+      }
+
+      // ... and number them in the order of their DOFs
+      IndexType size = 0;
+      for( int dof = 0; dof < dofSize; ++dof )
+      {
+        if( count ? (count[ dof ] > 0) : (array[ dof ] == 0) )
+          array[ dof ] = size++;
+      }
+      indexSet.size_[ codim ] = size;
+    }
+  };
+
+
+
+  // AlbertaGridIndexSet::TrackLeaf
+  // ------------------------------
+
+  /** \brief keeps the leaf indices of one codimension up to date during adaptation
+   *
+   *  ALBERTA calls interpolateVector for each patch of refined elements and
+   *  restrictVector for each patch of elements about to be coarsened.  Each
+   *  entity counts the leaf elements it belongs to, and it enters or leaves
+   *  the leaf when this count changes from or to zero.
+   */
+  template< int dim, int dimworld >
+  template< int codim >
+  struct AlbertaGridIndexSet< dim, dimworld >::TrackLeaf
+  {
+    typedef Alberta::DofAccess< dim, codim > DofAccess;
+    typedef Alberta::Patch< dim > Patch;
+
+    static void setup ( AlbertaGridIndexSet< dim, dimworld > &indexSet )
+    {
+      const Alberta::DofSpace *dofSpace = indexSet.dofNumbering_.dofSpace( codim );
+      indexSet.counts_[ codim ].create( dofSpace, "Index set leaf counts" );
+      indexSet.counts_[ codim ].initialize( 0 );
+
+      IndexVectorPointer &indices = indexSet.indices_[ codim ];
+      indices.template setupInterpolation< TrackLeaf >();
+      indices.template setupRestriction< TrackLeaf >();
+      indices.setAdaptationData( &indexSet );
+    }
+
+    static void interpolateVector ( const IndexVectorPointer &dofVector, const Patch &patch )
+    {
+      TrackLeaf track( dofVector );
+
+      // the entities created by the refinement are not contained yet
+      patch.template forEachInteriorSubChild< codim >( track );
+
+      // add the children before removing the fathers, such that shared entities stay
+      for( int i = 0; i < patch.count(); ++i )
+        for( int k = 0; k < 2; ++k )
+          track.add( patch[ i ]->child[ k ], +1 );
+      for( int i = 0; i < patch.count(); ++i )
+        track.add( patch[ i ], -1 );
+    }
+
+    static void restrictVector ( const IndexVectorPointer &dofVector, const Patch &patch )
+    {
+      TrackLeaf track( dofVector );
+      for( int i = 0; i < patch.count(); ++i )
+        track.add( patch[ i ], +1 );
+      for( int i = 0; i < patch.count(); ++i )
+        for( int k = 0; k < 2; ++k )
+          track.add( patch[ i ]->child[ k ], -1 );
+    }
+
+    // initialize an entity created by refinement
+    void operator() ( const Alberta::Element *child, int subEntity )
     {
-      int *const array = indexSet.indices_[ codim ];
-      IndexType &size = indexSet.size_[ codim ];
+      const int dof = dofAccess_( child, subEntity );
+      indices_[ dof ] = -1;
+      counts_[ dof ] = 0;
+    }
 
-      for( int i = 0; i < Alberta::NumSubEntities< dim, codim >::value; ++i )
+  private:
+    explicit TrackLeaf ( const IndexVectorPointer &dofVector )
+      : indexSet_( *dofVector.template getAdaptationData< AlbertaGridIndexSet< dim, dimworld > >() ),
+        dofAccess_( dofVector.dofSpace() ),
+        indices_( (IndexType *)dofVector ),
+        counts_( (IndexType *)indexSet_.counts_[ codim ] )
+    {}
+
+    // count an element entering (+1) or leaving (-1) the leaf for all its entities of this codimension
+    void add ( const Alberta::Element *element, int change )
+    {
+      for( int j = 0; j < DofAccess::numSubEntities; ++j )
       {
-        int &index = array[ indexSet.dofNumbering_( element, codim, i ) ];
-        if( index < 0 )
-          index = size++;
+        const int dof = dofAccess_( element, j );
+        counts_[ dof ] += change;
+        assert( counts_[ dof ] >= 0 );
+        if( (change > 0) && (counts_[ dof ] == 1) )
+          indices_[ dof ] = indexSet_.newIndex( codim );
+        else if( (change < 0) && (counts_[ dof ] == 0) )
+        {
+          indexSet_.freeIndices_[ codim ].push_back( indices_[ dof ] );
+          indices_[ dof ] = -1;
+        }
       }
     }
+
+    AlbertaGridIndexSet< dim, dimworld > &indexSet_;
+    DofAccess dofAccess_;
+    IndexType *indices_;
+    IndexType *counts_;
   };
 
 
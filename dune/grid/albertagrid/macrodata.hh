@@ -167,6 +167,21 @@ namespace Dune
         return vertexCount_++;
       }
 
+      /** \brief reserve memory for vertices and elements
+       *
+       *  Make room for the given total numbers of vertices and elements, so
+       *  that inserting them does not reallocate. This may only be done in
+       *  insert mode.
+       */
+      void reserve ( const int numVertices, const int numElements )
+      {
+        assert( (vertexCount_ >= 0) && (elementCount_ >= 0) );
+        if( numVertices > data_->n_total_vertices )
+          resizeVertices( numVertices );
+        if( numElements > data_->n_macro_elements )
+          resizeElements( numElements );
+      }
+
       void insertWallTrafo ( const GlobalMatrix &m, const GlobalVector &t );
       void insertWallTrafo ( const FieldMatrix< Real, dimWorld, dimWorld > &matrix,
                              const FieldVector< Real, dimWorld > &shift );
@@ -4,6 +4,8 @@
 #ifndef DUNE_ALBERTA_TREEITERATOR_HH
 #define DUNE_ALBERTA_TREEITERATOR_HH
 
+#include <vector>
+
 #include <dune/common/hybridutilities.hh>
 #include <dune/common/std/utility.hh>
 #include <dune/common/typetraits.hh>
@@ -253,6 +255,7 @@ namespace Dune
   private:
     void nextElement ( ElementInfo &elementInfo );
     void nextElementStop (ElementInfo &elementInfo );
+    void nextStopElement ( ElementInfo &elementInfo );
     bool stopAtElement ( const ElementInfo &elementInfo ) const;
 
     void goNext ( ElementInfo &elementInfo );
@@ -276,6 +279,10 @@ namespace Dune
 
     // knows on which element a point,edge,face is viewed
     const MarkerVector *marker_;
+
+    // current position in the leaf snapshot of the grid, if it is used
+    const ElementInfo *leafElement_;
+    const ElementInfo *leafEnd_;
   };
 
 
@@ -339,7 +346,9 @@ namespace Dune
       level_( -1 ),
       subEntity_( -1 ),
       macroIterator_(),
-      marker_( NULL )
+      marker_( NULL ),
+      leafElement_( nullptr ),
+      leafEnd_( nullptr )
   {}
 
   template< int codim, class GridImp, bool leafIterator >
@@ -351,10 +360,23 @@ namespace Dune
       level_( travLevel ),
       subEntity_( (codim == 0 ? 0 : -1) ),
       macroIterator_( grid.meshPointer().begin() ),
-      marker_( marker )
+      marker_( marker ),
+      leafElement_( nullptr ),
+      leafEnd_( nullptr )
   {
-    ElementInfo elementInfo = *macroIterator_;
-    nextElementStop( elementInfo );
+    ElementInfo elementInfo;
+    const std::vector< ElementInfo > *snapshot = (leafIterator ? grid.leafSnapshot() : nullptr);
+    if( snapshot )
+    {
+      leafElement_ = snapshot->data();
+      leafEnd_ = leafElement_ + snapshot->size();
+      elementInfo = *leafElement_;
+    }
+    else
+    {
+      elementInfo = *macroIterator_;
+      nextElementStop( elementInfo );
+    }
     if( codim > 0 )
       goNext( elementInfo );
     // it is ok to set the invalid ElementInfo
@@ -371,7 +393,9 @@ namespace Dune
       level_( travLevel ),
       subEntity_( -1 ),
       macroIterator_( grid.meshPointer().end() ),
-      marker_( 0 )
+      marker_( 0 ),
+      leafElement_( nullptr ),
+      leafEnd_( nullptr )
   {}
 
 
@@ -383,7 +407,9 @@ namespace Dune
       level_( other.level_ ),
       subEntity_( other.subEntity_ ),
       macroIterator_( other.macroIterator_ ),
-      marker_( other.marker_ )
+      marker_( other.marker_ ),
+      leafElement_( other.leafElement_ ),
+      leafEnd_( other.leafEnd_ )
   {}
 
 
@@ -397,6 +423,8 @@ namespace Dune
     subEntity_ =  other.subEntity_;
     macroIterator_ = other.macroIterator_;
     marker_ = other.marker_;
+    leafElement_ = other.leafElement_;
+    leafEnd_ = other.leafEnd_;
 
     return *this;
   }
@@ -442,6 +470,21 @@ namespace Dune
   }
 
 
+  template< int codim, class GridImp, bool leafIterator >
+  inline void AlbertaGridTreeIterator< codim, GridImp, leafIterator >
+  ::nextStopElement ( ElementInfo &elementInfo )
+  {
+    // the leaf snapshot already contains the stop elements only
+    if( leafElement_ )
+      elementInfo = (++leafElement_ != leafEnd_ ? *leafElement_ : ElementInfo());
+    else
+    {
+      nextElement( elementInfo );
+      nextElementStop( elementInfo );
+    }
+  }
+
+
   template< int codim, class GridImp, bool leafIterator >
   inline bool AlbertaGridTreeIterator< codim, GridImp, leafIterator >
   ::stopAtElement ( const ElementInfo &elementInfo ) const
@@ -467,8 +510,7 @@ namespace Dune
   {
     assert( stopAtElement( elementInfo ) );
 
-    nextElement( elementInfo );
-    nextElementStop( elementInfo );
+    nextStopElement( elementInfo );
   }
 
   template< int codim, class GridImp, bool leafIterator >
@@ -482,8 +524,7 @@ namespace Dune
     if( subEntity_ >= numSubEntities )
     {
       subEntity_ = 0;
-      nextElement( elementInfo );
-      nextElementStop( elementInfo );
+      nextStopElement( elementInfo );
       if( !elementInfo )
         return;
     }
@@ -524,8 +565,7 @@ namespace Dune
     if( subEntity_ >= numSubEntities )
     {
       subEntity_ = 0;
-      nextElement( elementInfo );
-      nextElementStop( elementInfo );
+      nextStopElement( elementInfo );
       if( !elementInfo )
         return;
     }
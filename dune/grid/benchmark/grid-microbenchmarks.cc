@@ -0,0 +1,104 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+/** \file
+ *  \brief Micro-benchmarks of the grid interface for YaspGrid, OneDGrid,
+ *         GeometryGrid and IdentityGrid, reported as JSON
+ *
+ *  Usage: grid-microbenchmarks [output.json] [elements per direction in 3d]
+ *
+ *  Without an output file, the report is written to the standard output.
+ */
+
+#include <config.h>
+
+#include <array>
+#include <bitset>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/geometrygrid.hh>
+#include <dune/grid/identitygrid.hh>
+#include <dune/grid/onedgrid.hh>
+#include <dune/grid/yaspgrid.hh>
+
+#include "microbenchmarks.hh"
+
+// a shear of the unit square, to give GeometryGrid some work to do
+class Shear
+  : public Dune::AnalyticalCoordFunction<double, 2, 2, Shear>
+{
+  typedef Dune::AnalyticalCoordFunction<double, 2, 2, Shear> Base;
+
+public:
+  typedef Base::DomainVector DomainVector;
+  typedef Base::RangeVector RangeVector;
+
+  void evaluate (const DomainVector& x, RangeVector& y) const
+  {
+    y[0] = x[0] + 0.5*x[1];
+    y[1] = x[1];
+  }
+};
+
+template<int dim>
+std::array<int,dim> uniformSize (int n)
+{
+  std::array<int,dim> s;
+  s.fill(n);
+  return s;
+}
+
+int main (int argc, char** argv)
+{
+  const auto& mpiHelper = Dune::MPIHelper::instance(argc, argv);
+
+  const std::string output = (argc > 1) ? argv[1] : "";
+  const int n = (argc > 2) ? std::atoi(argv[2]) : 32;
+
+  Dune::Benchmark::Report report(mpiHelper.getCollectiveCommunication());
+
+  {
+    Dune::YaspGrid<3> grid(Dune::FieldVector<double,3>(1.0), uniformSize<3>(n), std::bitset<3>(0ULL), 1);
+    Dune::Benchmark::runGridBenchmarks(report, "YaspGrid<3>", grid);
+    Dune::Benchmark::runCommunicationBenchmarks(report, "YaspGrid<3>", grid);
+
+    Dune::IdentityGrid<Dune::YaspGrid<3> > identityGrid(grid);
+    Dune::Benchmark::runGridBenchmarks(report, "IdentityGrid<YaspGrid<3>>", identityGrid);
+  }
+
+  {
+    const int n2 = n*n/4;
+    Dune::YaspGrid<2> grid(Dune::FieldVector<double,2>(1.0), uniformSize<2>(n2), std::bitset<2>(0ULL), 1);
+    Dune::Benchmark::runGridBenchmarks(report, "YaspGrid<2>", grid);
+    Dune::Benchmark::runCommunicationBenchmarks(report, "YaspGrid<2>", grid);
+
+    Shear shear;
+    Dune::GeometryGrid<Dune::YaspGrid<2>, Shear> geometryGrid(grid, shear);
+    Dune::Benchmark::runGridBenchmarks(report, "GeometryGrid<YaspGrid<2>>", geometryGrid);
+    Dune::Benchmark::runCommunicationBenchmarks(report, "GeometryGrid<YaspGrid<2>>", geometryGrid);
+  }
+
+  {
+    Dune::OneDGrid grid(n*n*n, 0.0, 1.0);
+    Dune::Benchmark::runGridBenchmarks(report, "OneDGrid", grid);
+  }
+
+  if (mpiHelper.rank() == 0)
+  {
+    if (output.empty())
+      report.write(std::cout);
+    else
+    {
+      std::ofstream file(output);
+      report.write(file);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,362 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_BENCHMARK_MICROBENCHMARKS_HH
+#define DUNE_GRID_BENCHMARK_MICROBENCHMARKS_HH
+
+/** \file
+ *  \brief Micro-benchmarks for the hot paths of the grid interface and a
+ *         report collecting their results as JSON
+ *
+ *  Each benchmark is a function running over a grid view once and returning
+ *  the number of operations it performed together with a checksum, which
+ *  keeps the compiler from optimizing the work away.  It is repeated until a
+ *  minimum time has passed on all processes, and the fastest repetition is
+ *  reported.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dune/common/timer.hh>
+#include <dune/common/parallel/collectivecommunication.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/geometry/referenceelements.hh>
+
+#include <dune/grid/common/datahandleif.hh>
+#include <dune/grid/common/gridenums.hh>
+#include <dune/grid/common/mcmgmapper.hh>
+#include <dune/grid/common/rangegenerators.hh>
+
+namespace Dune
+{
+  namespace Benchmark
+  {
+
+    //! The result of one benchmark
+    struct Result
+    {
+      std::string grid;
+      std::string name;
+      std::size_t operations;
+      int repetitions;
+      double seconds;
+    };
+
+    /** \brief Run benchmarks and collect their results
+     *
+     * The report is written as a JSON object of the form
+     * <tt>{"benchmarks": [{"grid": ..., "name": ..., "operations": ...,
+     * "repetitions": ..., "seconds": ..., "ns_per_operation": ...}, ...],
+     * "checksum": ...}</tt>, where seconds is the time of the fastest
+     * repetition.  The checksum is written such that the compiler cannot
+     * optimize the benchmarks away.
+     */
+    class Report
+    {
+    public:
+      typedef CollectiveCommunication<MPIHelper::MPICommunicator> Communication;
+
+      /** \brief Constructor
+       *
+       * \param comm           The communicator of the grids, all processes repeat
+       *                       each benchmark equally often
+       * \param minTime        Repeat each benchmark until this many seconds have passed
+       * \param maxRepetitions Never repeat a benchmark more often than this
+       */
+      explicit Report (const Communication& comm, double minTime = 0.2, int maxRepetitions = 1000)
+        : comm_(comm), minTime_(minTime), maxRepetitions_(maxRepetitions), checksum_(0)
+      {}
+
+      /** \brief Time a benchmark
+       *
+       * \param grid  A name of the grid, for the report
+       * \param name  A name of the benchmark, for the report
+       * \param f     Function without arguments returning a std::pair of
+       *              the number of operations and a checksum
+       */
+      template<class F>
+      const Result& run (const std::string& grid, const std::string& name, F&& f)
+      {
+        // warm up the caches and the lazily built data structures
+        auto count = f();
+        checksum_ += count.second;
+
+        Result result{grid, name, std::size_t(count.first), 0, std::numeric_limits<double>::max()};
+        Timer total;
+        int repeat = 1;
+        do {
+          Timer timer;
+          count = f();
+          result.seconds = std::min(result.seconds, timer.elapsed());
+          checksum_ += count.second;
+          ++result.repetitions;
+
+          // the benchmark may communicate, so all processes have to stop together
+          repeat = (total.elapsed() < minTime_ && result.repetitions < maxRepetitions_);
+          repeat = comm_.max(repeat);
+        } while (repeat);
+
+        results_.push_back(result);
+        return results_.back();
+      }
+
+      //! All results so far
+      const std::vector<Result>& results () const
+      {
+        return results_;
+      }
+
+      //! The sum of the checksums of all benchmarks
+      double checksum () const
+      {
+        return checksum_;
+      }
+
+      //! Write the results as JSON
+      void write (std::ostream& out) const
+      {
+        out << "{\n  \"benchmarks\": [";
+        for (std::size_t i = 0; i < results_.size(); ++i)
+        {
+          const Result& r = results_[i];
+          const double ns = (r.operations > 0) ? r.seconds / r.operations * 1e9 : 0.0;
+          out << (i > 0 ? "," : "") << "\n    {"
+              << "\"grid\": " << jsonString(r.grid) << ", "
+              << "\"name\": " << jsonString(r.name) << ", "
+              << "\"operations\": " << r.operations << ", "
+              << "\"repetitions\": " << r.repetitions << ", "
+              << "\"seconds\": " << r.seconds << ", "
+              << "\"ns_per_operation\": " << ns << "}";
+        }
+        out << "\n  ],\n  \"checksum\": " << checksum_ << "\n}" << std::endl;
+      }
+
+    private:
+      // a string as a quoted JSON string, with quotes, backslashes and control characters escaped
+      static std::string jsonString (const std::string& s)
+      {
+        std::string quoted = "\"";
+        for (const char c : s)
+        {
+          if (c == '"' || c == '\\')
+            quoted += std::string("\\") + c;
+          else if (static_cast<unsigned char>(c) < 0x20)
+          {
+            char escaped[7];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+            quoted += escaped;
+          }
+          else
+            quoted += c;
+        }
+        return quoted + "\"";
+      }
+
+      Communication comm_;
+      double minTime_;
+      int maxRepetitions_;
+      double checksum_;
+      std::vector<Result> results_;
+    };
+
+    //! Iterate over all elements
+    template<class GridView>
+    std::pair<std::size_t, double> elementIteration (const GridView& gv)
+    {
+      std::size_t count = 0;
+      for (const auto& element : elements(gv))
+        count += element.level() + 1;
+      return { gv.size(0), double(count) };
+    }
+
+    //! Iterate over the intersections of all elements
+    template<class GridView>
+    std::pair<std::size_t, double> intersectionIteration (const GridView& gv)
+    {
+      std::size_t count = 0, neighbors = 0;
+      for (const auto& element : elements(gv))
+        for (const auto& intersection : intersections(gv, element))
+        {
+          ++count;
+          neighbors += intersection.neighbor();
+        }
+      return { count, double(neighbors) };
+    }
+
+    //! Evaluate the centers of the element geometries
+    template<class GridView>
+    std::pair<std::size_t, double> geometryCenter (const GridView& gv)
+    {
+      double sum = 0.0;
+      for (const auto& element : elements(gv))
+        sum += element.geometry().center()[0];
+      return { gv.size(0), sum };
+    }
+
+    //! Evaluate the inverse transposed Jacobians of the element geometries at the centers of the reference elements
+    template<class GridView>
+    std::pair<std::size_t, double> jacobianInverseTransposed (const GridView& gv)
+    {
+      double sum = 0.0;
+      for (const auto& element : elements(gv))
+      {
+        const auto geometry = element.geometry();
+        const auto local = referenceElement<typename GridView::ctype, GridView::dimension>(element.type()).position(0, 0);
+        const auto jit = geometry.jacobianInverseTransposed(local);
+        sum += jit[0][0];
+      }
+      return { gv.size(0), sum };
+    }
+
+    //! Look up the indices of the vertices of all elements in the index set
+    template<class GridView>
+    std::pair<std::size_t, double> vertexSubIndex (const GridView& gv)
+    {
+      const int dim = GridView::dimension;
+      const auto& indexSet = gv.indexSet();
+      std::size_t count = 0, sum = 0;
+      for (const auto& element : elements(gv))
+        for (unsigned int i = 0; i < element.subEntities(dim); ++i, ++count)
+          sum += indexSet.subIndex(element, i, dim);
+      return { count, double(sum) };
+    }
+
+    //! Look up the global ids of all elements
+    template<class GridView>
+    std::pair<std::size_t, double> globalId (const GridView& gv)
+    {
+      const auto& idSet = gv.grid().globalIdSet();
+      typename std::decay_t<decltype(idSet)>::IdType last{};
+      std::size_t changes = 0;
+      for (const auto& element : elements(gv))
+      {
+        const auto id = idSet.id(element);
+        changes += !(id == last);
+        last = id;
+      }
+      return { gv.size(0), double(changes) };
+    }
+
+    //! Look up the indices of the vertices of all elements in a vertex mapper
+    template<class GridView>
+    std::pair<std::size_t, double> mapperSubIndex (const MultipleCodimMultipleGeomTypeMapper<GridView>& mapper, const GridView& gv)
+    {
+      const int dim = GridView::dimension;
+      std::size_t count = 0, sum = 0;
+      for (const auto& element : elements(gv))
+        for (unsigned int i = 0; i < element.subEntities(dim); ++i, ++count)
+          sum += mapper.subIndex(element, i, dim);
+      return { count, double(sum) };
+    }
+
+    //! Data handle adding the values of neighboring processes to a vector indexed by a mapper
+    template<class Mapper>
+    class AddDataHandle
+      : public CommDataHandleIF<AddDataHandle<Mapper>, double>
+    {
+    public:
+      AddDataHandle (const Mapper& mapper, std::vector<double>& data, int codim)
+        : mapper_(mapper), data_(data), codim_(codim)
+      {}
+
+      bool contains (int, int codim) const { return codim == codim_; }
+      bool fixedSize (int, int) const { return true; }
+
+      template<class Entity>
+      std::size_t size (const Entity&) const { return 1; }
+
+      template<class Buffer, class Entity>
+      void gather (Buffer& buffer, const Entity& entity) const
+      {
+        buffer.write(data_[mapper_.index(entity)]);
+      }
+
+      template<class Buffer, class Entity>
+      void scatter (Buffer& buffer, const Entity& entity, std::size_t)
+      {
+        double x;
+        buffer.read(x);
+        data_[mapper_.index(entity)] += x;
+      }
+
+    private:
+      const Mapper& mapper_;
+      std::vector<double>& data_;
+      int codim_;
+    };
+
+    //! Communicate one double per entity of the mapper on the given interface
+    template<class GridView>
+    std::pair<std::size_t, double> communicate (const MultipleCodimMultipleGeomTypeMapper<GridView>& mapper, const GridView& gv,
+                                                int codim, InterfaceType interface)
+    {
+      std::vector<double> data(mapper.size(), 1.0);
+      AddDataHandle<MultipleCodimMultipleGeomTypeMapper<GridView> > dataHandle(mapper, data, codim);
+      gv.communicate(dataHandle, interface, ForwardCommunication);
+
+      double sum = 0.0;
+      for (double x : data)
+        sum += x;
+      return { mapper.size(), sum };
+    }
+
+    /** \brief Run all benchmarks that only need the grid interface on the leaf and the finest level view of a grid
+     *
+     * \param report The report collecting the results
+     * \param name   A name of the grid, for the report
+     * \param grid   The grid
+     */
+    template<class Grid>
+    void runGridBenchmarks (Report& report, const std::string& name, const Grid& grid)
+    {
+      typedef typename Grid::LeafGridView LeafGridView;
+      const LeafGridView leaf = grid.leafGridView();
+      const auto level = grid.levelGridView(grid.maxLevel());
+
+      report.run(name, "leaf element iteration", [&] { return elementIteration(leaf); });
+      report.run(name, "level element iteration", [&] { return elementIteration(level); });
+      report.run(name, "leaf intersection iteration", [&] { return intersectionIteration(leaf); });
+      report.run(name, "geometry center", [&] { return geometryCenter(leaf); });
+      report.run(name, "jacobianInverseTransposed", [&] { return jacobianInverseTransposed(leaf); });
+      report.run(name, "index set vertex subIndex", [&] { return vertexSubIndex(leaf); });
+      report.run(name, "global id set element id", [&] { return globalId(leaf); });
+
+      const MultipleCodimMultipleGeomTypeMapper<LeafGridView> mapper(leaf, mcmgVertexLayout());
+      report.run(name, "mapper vertex subIndex", [&] { return mapperSubIndex(mapper, leaf); });
+    }
+
+    /** \brief Run the communication benchmark on the vertices of the leaf view of a grid
+     *
+     * \param report The report collecting the results
+     * \param name   A name of the grid, for the report
+     * \param grid   The grid, which has to support communication on vertices
+     */
+    template<class Grid>
+    void runCommunicationBenchmarks (Report& report, const std::string& name, const Grid& grid)
+    {
+      typedef typename Grid::LeafGridView LeafGridView;
+      const LeafGridView leaf = grid.leafGridView();
+      const int dim = Grid::dimension;
+
+      const MultipleCodimMultipleGeomTypeMapper<LeafGridView> mapper(leaf, mcmgVertexLayout());
+      report.run(name, "communicate vertices InteriorBorder_All", [&] {
+          return communicate(mapper, leaf, dim, InteriorBorder_All_Interface);
+        });
+      report.run(name, "communicate vertices All_All", [&] {
+          return communicate(mapper, leaf, dim, All_All_Interface);
+        });
+    }
+
+  } // namespace Benchmark
+
+} // namespace Dune
+
+#endif // DUNE_GRID_BENCHMARK_MICROBENCHMARKS_HH
@@ -0,0 +1,183 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_BENCHMARK_SCALINGBENCHMARKS_HH
+#define DUNE_GRID_BENCHMARK_SCALINGBENCHMARKS_HH
+
+/** \file
+ *  \brief Helpers for weak and strong scaling benchmarks of parallel grid operations
+ *
+ *  Each process records the time of each phase of each operation.  At the end,
+ *  the times are reduced over all processes, and rank 0 writes the minimum, mean
+ *  and maximum of each phase as JSON.  The maximum is the time of the operation,
+ *  the ratio of maximum and mean shows the load imbalance.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <dune/common/timer.hh>
+
+#include <dune/grid/common/datahandleif.hh>
+
+namespace Dune
+{
+  namespace Benchmark
+  {
+
+    /** \brief Collects the per-phase timings of a scaling run and writes them as JSON from rank 0
+     *
+     * All processes have to add the same operations and phases in the same order.
+     */
+    class ScalingReport
+    {
+      struct Entry
+      {
+        std::string operation;
+        std::string phase;
+        double seconds;
+      };
+
+    public:
+      /** \brief Constructor
+       *
+       * \param mode  "weak" or "strong", for the report
+       * \param size  The problem size parameter of the run, for the report
+       */
+      ScalingReport (const std::string& mode, int size)
+        : mode_(mode), size_(size)
+      {}
+
+      //! Record the time this process spent in a phase of an operation
+      void add (const std::string& operation, const std::string& phase, double seconds)
+      {
+        entries_.push_back({operation, phase, seconds});
+      }
+
+      /** \brief Reduce the times over all processes and write the report on rank 0
+       *
+       * This is a collective operation.
+       */
+      template<class Comm>
+      void write (std::ostream& out, const Comm& comm) const
+      {
+        const std::size_t n = entries_.size();
+        std::vector<double> min(n), max(n), sum(n);
+        for (std::size_t i = 0; i < n; ++i)
+          min[i] = max[i] = sum[i] = entries_[i].seconds;
+
+        if (n > 0)
+        {
+          comm.min(min.data(), n);
+          comm.max(max.data(), n);
+          comm.sum(sum.data(), n);
+        }
+
+        if (comm.rank() != 0)
+          return;
+
+        out << "{\n  \"mode\": \"" << mode_ << "\",\n"
+            << "  \"processes\": " << comm.size() << ",\n"
+            << "  \"size\": " << size_ << ",\n"
+            << "  \"results\": [";
+        for (std::size_t i = 0; i < n; ++i)
+          out << (i > 0 ? "," : "") << "\n    {"
+              << "\"operation\": \"" << entries_[i].operation << "\", "
+              << "\"phase\": \"" << entries_[i].phase << "\", "
+              << "\"min\": " << min[i] << ", "
+              << "\"mean\": " << sum[i] / comm.size() << ", "
+              << "\"max\": " << max[i] << "}";
+        out << "\n  ]\n}" << std::endl;
+      }
+
+    private:
+      std::string mode_;
+      int size_;
+      std::vector<Entry> entries_;
+    };
+
+    /** \brief Time a collective operation on all processes
+     *
+     * The processes are synchronized before the operation starts, such that the
+     * time of each process is the time it spent in the operation itself.
+     */
+    template<class Comm, class F>
+    double timeCollective (const Comm& comm, F&& f)
+    {
+      comm.barrier();
+      Timer timer;
+      f();
+      return timer.elapsed();
+    }
+
+    /** \brief Data handle communicating one double per entity of one codimension, timing gather and scatter
+     *
+     * The time spent in gather is the packing time, the time spent in scatter
+     * the unpacking time of the communication.  The remaining time of the
+     * communication is spent in setting up and exchanging the messages.  The
+     * timers add an overhead of a few nanoseconds per entity.
+     *
+     * \tparam Mapper Maps the entities to consecutive indices
+     */
+    template<class Mapper>
+    class TimedDataHandle
+      : public CommDataHandleIF<TimedDataHandle<Mapper>, double>
+    {
+      typedef std::chrono::steady_clock Clock;
+
+    public:
+      TimedDataHandle (const Mapper& mapper, std::vector<double>& data, int codim)
+        : mapper_(mapper), data_(data), codim_(codim), pack_(0), unpack_(0)
+      {}
+
+      bool contains (int, int codim) const { return codim == codim_; }
+      bool fixedSize (int, int) const { return true; }
+
+      template<class Entity>
+      std::size_t size (const Entity&) const { return 1; }
+
+      template<class Buffer, class Entity>
+      void gather (Buffer& buffer, const Entity& entity) const
+      {
+        const auto start = Clock::now();
+        buffer.write(data_[mapper_.index(entity)]);
+        pack_ += Clock::now() - start;
+      }
+
+      template<class Buffer, class Entity>
+      void scatter (Buffer& buffer, const Entity& entity, std::size_t)
+      {
+        const auto start = Clock::now();
+        double x;
+        buffer.read(x);
+        data_[mapper_.index(entity)] += x;
+        unpack_ += Clock::now() - start;
+      }
+
+      //! Seconds spent in gather
+      double packTime () const
+      {
+        return std::chrono::duration<double>(pack_).count();
+      }
+
+      //! Seconds spent in scatter
+      double unpackTime () const
+      {
+        return std::chrono::duration<double>(unpack_).count();
+      }
+
+    private:
+      const Mapper& mapper_;
+      std::vector<double>& data_;
+      int codim_;
+      mutable Clock::duration pack_;
+      Clock::duration unpack_;
+    };
+
+  } // namespace Benchmark
+
+} // namespace Dune
+
+#endif // DUNE_GRID_BENCHMARK_SCALINGBENCHMARKS_HH
@@ -0,0 +1,111 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+/** \file
+ *  \brief Time the boundary face detection of the UGGrid factory on a
+ *         tetrahedral mesh of a cube, and compare with face matching
+ *         through a std::set
+ *
+ *  With the default of 120 cells per direction, the mesh has 10.4M tetrahedra.
+ *
+ *  Usage: uggrid-boundaryextractor [cells per direction] [compare with std::set (0/1)]
+ */
+
+#include <config.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <vector>
+
+#include <dune/common/timer.hh>
+
+#include <dune/grid/uggrid/boundaryextractor.hh>
+
+// split each cube of an n^3 grid into the six tetrahedra around its main diagonal
+void kuhnMesh (unsigned int n, std::vector<unsigned char>& elementTypes, std::vector<unsigned int>& elementVertices)
+{
+  static const int paths[6][3] = {
+    {1,2,4}, {1,4,2}, {2,1,4}, {2,4,1}, {4,1,2}, {4,2,1}
+  };
+
+  const std::size_t numElements = 6*std::size_t(n)*n*n;
+  elementTypes.assign(numElements, 4);
+  elementVertices.clear();
+  elementVertices.reserve(4*numElements);
+
+  auto vertex = [n] (unsigned int i, unsigned int j, unsigned int k) { return i + (n+1)*(j + (n+1)*k); };
+
+  for (unsigned int k=0; k<n; k++)
+    for (unsigned int j=0; j<n; j++)
+      for (unsigned int i=0; i<n; i++)
+        for (const auto& path : paths) {
+          int corner = 0;
+          elementVertices.push_back(vertex(i, j, k));
+          for (int step : path) {
+            corner += step;
+            elementVertices.push_back(vertex(i + (corner & 1), j + ((corner >> 1) & 1), k + ((corner >> 2) & 1)));
+          }
+        }
+}
+
+// the face matching the UGGrid factory used before, for comparison
+void detectWithSet (const std::vector<unsigned char>& elementTypes,
+                    const std::vector<unsigned int>& elementVertices,
+                    std::set<Dune::UGGridBoundarySegment<3> >& boundarySegments)
+{
+  static const int tetraIdx[][4] = {
+    {1,3,2,2},{0,2,3,3},{0,3,1,1},{0,1,2,2}
+  };
+
+  for (std::size_t i=0, base=0; i<elementTypes.size(); i++, base+=4)
+    for (int k=0; k<4; k++) {
+      Dune::UGGridBoundarySegment<3> v;
+      for (int j=0; j<4; j++)
+        v[j] = elementVertices[base+tetraIdx[k][j]];
+      v[3] = -1;
+
+      auto status = boundarySegments.insert(v);
+      if (!status.second)
+        boundarySegments.erase(status.first);
+    }
+}
+
+int main (int argc, char** argv)
+{
+  const unsigned int n = (argc > 1) ? std::atoi(argv[1]) : 120;
+  const bool compare = (argc > 2) ? std::atoi(argv[2]) : true;
+
+  std::vector<unsigned char> elementTypes;
+  std::vector<unsigned int> elementVertices;
+  kuhnMesh(n, elementTypes, elementVertices);
+
+  Dune::Timer timer;
+  std::vector<Dune::UGGridBoundarySegment<3> > boundarySegments;
+  Dune::BoundaryExtractor::detectBoundarySegments(elementTypes, elementVertices, boundarySegments);
+  const double t = timer.elapsed();
+
+  std::cout << "tetrahedra:        " << elementTypes.size() << std::endl;
+  std::cout << "boundary faces:    " << boundarySegments.size()
+            << " (expected " << 12*std::size_t(n)*n << ")" << std::endl;
+  std::cout << "sorted matching:   " << t << " s" << std::endl;
+
+  bool passed = (boundarySegments.size() == 12*std::size_t(n)*n);
+
+  if (compare)
+  {
+    timer.reset();
+    std::set<Dune::UGGridBoundarySegment<3> > setSegments;
+    detectWithSet(elementTypes, elementVertices, setSegments);
+    const double tSet = timer.elapsed();
+
+    std::cout << "std::set matching: " << tSet << " s" << std::endl;
+    std::cout << "speedup:           " << tSet / t << std::endl;
+
+    passed = passed && std::equal(setSegments.begin(), setSegments.end(), boundarySegments.begin(), boundarySegments.end());
+  }
+
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+/** \file
+ *  \brief Time UGGrid::loadBalance(targetProcessors, fromLevel) on a uniformly
+ *         refined 3d cube, moving all leaf elements between two partitions
+ *
+ *  Usage: mpirun -np <P> uggrid-loadbalance [coarse cells per direction] [levels] [repetitions]
+ */
+
+#include <config.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
+
+#include <dune/grid/uggrid.hh>
+#include <dune/grid/common/mcmgmapper.hh>
+#include <dune/grid/utility/structuredgridfactory.hh>
+
+const int dim = 3;
+typedef Dune::UGGrid<dim> Grid;
+
+// target rank of each leaf element: slabs in x direction, optionally in reverse order
+std::vector<unsigned> slabs (const Grid& grid, bool reverse)
+{
+  const auto gv = grid.leafGridView();
+  const int P = grid.comm().size();
+  Dune::MultipleCodimMultipleGeomTypeMapper<Grid::LeafGridView> mapper(gv, Dune::mcmgElementLayout());
+
+  std::vector<unsigned> part(gv.size(0), 0);
+  for (const auto& element : elements(gv, Dune::Partitions::interior))
+  {
+    int p = std::min(int(element.geometry().center()[0] * P), P-1);
+    part[mapper.index(element)] = reverse ? P-1-p : p;
+  }
+  return part;
+}
+
+int main (int argc, char** argv)
+{
+  const auto& mpiHelper = Dune::MPIHelper::instance(argc, argv);
+
+  const unsigned int n = (argc > 1) ? std::atoi(argv[1]) : 2;
+  const int levels = (argc > 2) ? std::atoi(argv[2]) : 6;
+  const int repetitions = (argc > 3) ? std::atoi(argv[3]) : 4;
+
+  Dune::FieldVector<double,dim> lower(0.0), upper(1.0);
+  std::array<unsigned int,dim> elements;
+  std::fill(elements.begin(), elements.end(), n);
+  std::shared_ptr<Grid> grid = Dune::StructuredGridFactory<Grid>::createCubeGrid(lower, upper, elements);
+
+  // distribute the coarse grid first, the refinement then stays local
+  grid->loadBalance();
+  grid->globalRefine(levels);
+
+  int leafElements = grid->leafGridView().size(0);
+  leafElements = grid->comm().sum(leafElements);
+
+  Dune::Timer timer;
+  double t = 0.0;
+  for (int r = 0; r < repetitions; ++r)
+  {
+    const auto part = slabs(*grid, r % 2 == 1);
+    grid->comm().barrier();
+    timer.reset();
+    grid->loadBalance(part, 0);
+    grid->comm().barrier();
+    t += timer.elapsed();
+  }
+
+  if (mpiHelper.rank() == 0)
+  {
+    std::cout << "processes:     " << mpiHelper.size() << std::endl;
+    std::cout << "levels:        " << levels << std::endl;
+    std::cout << "leaf elements: " << leafElements << std::endl;
+    std::cout << "loadBalance:   " << t / repetitions << " s" << std::endl;
+  }
+
+  return 0;
+}
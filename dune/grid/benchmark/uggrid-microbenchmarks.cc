@@ -0,0 +1,74 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+/** \file
+ *  \brief Micro-benchmarks of the grid interface for UGGrid, reported as JSON
+ *
+ *  The grids are uniformly refined cubes, once with hexahedra and once with tetrahedra.
+ *
+ *  Usage: mpirun -np <P> uggrid-microbenchmarks [output.json] [coarse elements per direction] [levels]
+ *
+ *  Without an output file, the report is written to the standard output.
+ */
+
+#include <config.h>
+
+#include <array>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/uggrid.hh>
+#include <dune/grid/utility/structuredgridfactory.hh>
+
+#include "microbenchmarks.hh"
+
+int main (int argc, char** argv)
+{
+  const auto& mpiHelper = Dune::MPIHelper::instance(argc, argv);
+
+  const std::string output = (argc > 1) ? argv[1] : "";
+  const unsigned int n = (argc > 2) ? std::atoi(argv[2]) : 4;
+  const int levels = (argc > 3) ? std::atoi(argv[3]) : 3;
+
+  typedef Dune::UGGrid<3> Grid;
+  typedef Dune::StructuredGridFactory<Grid> Factory;
+
+  Dune::FieldVector<double,3> lower(0.0), upper(1.0);
+  std::array<unsigned int,3> elements;
+  elements.fill(n);
+
+  Dune::Benchmark::Report report(mpiHelper.getCollectiveCommunication());
+
+  // parallel UGGrid can only have one grid at a time
+  for (bool simplices : {false, true})
+  {
+    std::unique_ptr<Grid> grid = simplices
+      ? Factory::createSimplexGrid(lower, upper, elements)
+      : Factory::createCubeGrid(lower, upper, elements);
+    grid->loadBalance();
+    grid->globalRefine(levels);
+
+    const std::string name = simplices ? "UGGrid<3> tetrahedra" : "UGGrid<3> hexahedra";
+    Dune::Benchmark::runGridBenchmarks(report, name, *grid);
+    Dune::Benchmark::runCommunicationBenchmarks(report, name, *grid);
+  }
+
+  if (mpiHelper.rank() == 0)
+  {
+    if (output.empty())
+      report.write(std::cout);
+    else
+    {
+      std::ofstream file(output);
+      report.write(file);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,171 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+/** \file
+ *  \brief Weak and strong scaling of UGGrid::loadBalance with data migration, reported as JSON
+ *
+ *  A uniformly refined cube of hexahedra is distributed, partitioned along a
+ *  Hilbert curve, and then moved between the processes twice, with the
+ *  coordinates of all elements and vertices as data.  Each migration is split
+ *  into computing the partition (setup), packing the data (gather), migrating
+ *  the grid and the data, and unpacking the data (scatter).
+ *
+ *  For weak scaling, the coarse grid has n*P x n x n elements on P processes,
+ *  for strong scaling n x n x n elements.
+ *
+ *  Usage: mpirun -np <P> uggrid-scaling [weak|strong] [n] [levels] [output.json]
+ *
+ *  Without an output file, the report is written to the standard output.
+ */
+
+#include <config.h>
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/uggrid.hh>
+#include <dune/grid/common/datahandleif.hh>
+#include <dune/grid/utility/spacefillingcurvepartitioner.hh>
+#include <dune/grid/utility/structuredgridfactory.hh>
+
+#include "scalingbenchmarks.hh"
+
+const int dim = 3;
+typedef Dune::UGGrid<dim> Grid;
+typedef Grid::LeafGridView GridView;
+
+// migrate the centers of all elements and vertices, timing gather and scatter
+class CenterDataHandle
+  : public Dune::CommDataHandleIF<CenterDataHandle, double>
+{
+  typedef std::chrono::steady_clock Clock;
+
+public:
+  CenterDataHandle ()
+    : pack_(0), unpack_(0), sum_(0.0)
+  {}
+
+  bool contains (int, int codim) const { return codim == 0 || codim == dim; }
+  bool fixedSize (int, int) const { return true; }
+
+  template<class Entity>
+  std::size_t size (const Entity&) const { return dim; }
+
+  template<class Buffer, class Entity>
+  void gather (Buffer& buffer, const Entity& entity) const
+  {
+    const auto start = Clock::now();
+    const auto center = entity.geometry().center();
+    for (int i = 0; i < dim; ++i)
+      buffer.write(center[i]);
+    pack_ += Clock::now() - start;
+  }
+
+  template<class Buffer, class Entity>
+  void scatter (Buffer& buffer, const Entity&, std::size_t n)
+  {
+    const auto start = Clock::now();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      double x;
+      buffer.read(x);
+      sum_ += x;
+    }
+    unpack_ += Clock::now() - start;
+  }
+
+  double packTime () const { return std::chrono::duration<double>(pack_).count(); }
+  double unpackTime () const { return std::chrono::duration<double>(unpack_).count(); }
+  double sum () const { return sum_; }
+
+private:
+  mutable Clock::duration pack_;
+  Clock::duration unpack_;
+  double sum_;
+};
+
+int main (int argc, char** argv)
+{
+  const auto& mpiHelper = Dune::MPIHelper::instance(argc, argv);
+
+  const std::string mode = (argc > 1) ? argv[1] : "weak";
+  const unsigned int n = (argc > 2) ? std::atoi(argv[2]) : 4;
+  const int levels = (argc > 3) ? std::atoi(argv[3]) : 3;
+  const std::string output = (argc > 4) ? argv[4] : "";
+
+  if (mode != "weak" && mode != "strong")
+    DUNE_THROW(Dune::Exception, "Unknown scaling mode '" << mode << "', use 'weak' or 'strong'");
+
+  const int P = mpiHelper.size();
+
+  std::array<unsigned int,dim> elements;
+  elements.fill(n);
+  Dune::FieldVector<double,dim> lower(0.0), upper(1.0);
+  if (mode == "weak")
+  {
+    elements[0] *= P;
+    upper[0] *= P;
+  }
+
+  Dune::Benchmark::ScalingReport report(mode, n);
+
+  std::shared_ptr<Grid> grid = Dune::StructuredGridFactory<Grid>::createCubeGrid(lower, upper, elements);
+  const auto& comm = grid->comm();
+
+  // distribute the coarse grid, the refinement then stays local
+  report.add("initial distribution", "migrate", Dune::Benchmark::timeCollective(comm, [&] {
+        grid->loadBalance();
+      }));
+  report.add("globalRefine", "setup", Dune::Benchmark::timeCollective(comm, [&] {
+        grid->globalRefine(levels);
+      }));
+
+  // first move to the Hilbert curve partition, then reverse the ranks to move (almost) everything
+  double checksum = 0.0;
+  for (bool reverse : {false, true})
+  {
+    std::vector<unsigned> part;
+    const double setup = Dune::Benchmark::timeCollective(comm, [&] {
+        part = Dune::SpaceFillingCurvePartitioner<GridView>::partition(grid->leafGridView());
+      });
+    if (reverse)
+      for (auto& p : part)
+        p = P-1-p;
+
+    CenterDataHandle dataHandle;
+    const double total = Dune::Benchmark::timeCollective(comm, [&] {
+        grid->loadBalance(part, 0, dataHandle);
+      });
+    checksum += dataHandle.sum();
+
+    const std::string operation = reverse ? "loadBalance reversed" : "loadBalance Hilbert";
+    report.add(operation, "setup", setup);
+    report.add(operation, "pack", dataHandle.packTime());
+    report.add(operation, "migrate", total - dataHandle.packTime() - dataHandle.unpackTime());
+    report.add(operation, "unpack", dataHandle.unpackTime());
+    report.add(operation, "total", setup + total);
+  }
+
+  if (output.empty())
+    report.write(std::cout, comm);
+  else
+  {
+    std::ofstream file;
+    if (mpiHelper.rank() == 0)
+      file.open(output);
+    report.write(file, comm);
+  }
+
+  // the checksum keeps the compiler from optimizing the data handle away
+  return (checksum == -1.0) ? 1 : 0;
+}
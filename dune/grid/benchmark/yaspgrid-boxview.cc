@@ -0,0 +1,123 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+/** \file
+ *  \brief Compare a 7-point stencil applied via entity iterators with the
+ *         same stencil applied via the YaspBoxView of the grid
+ *
+ *  Usage: yaspgrid-boxview [cells per direction] [repetitions]
+ */
+
+#include <config.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
+
+#include <dune/grid/yaspgrid.hh>
+
+const int dim = 3;
+typedef Dune::YaspGrid<dim> Grid;
+
+// apply the stencil element by element, looking up neighbors through intersections
+template<class GridView>
+void applyIterator (const GridView& gv, const std::vector<double>& u, std::vector<double>& y)
+{
+  const auto& indexSet = gv.indexSet();
+  for (const auto& element : elements(gv))
+  {
+    const auto idx = indexSet.index(element);
+    double v = 2.0*dim*u[idx];
+    for (const auto& intersection : intersections(gv, element))
+      if (intersection.neighbor())
+        v -= u[indexSet.index(intersection.outside())];
+    y[idx] = v;
+  }
+}
+
+// apply the stencil by nested loops over the element box
+template<class BoxView>
+void applyBox (const BoxView& bv, const std::vector<double>& u, std::vector<double>& y)
+{
+  const auto& box = bv.box(0, 0);
+  const auto stride = bv.strides(0, 0);
+  const int first = bv.index(0, 0, box.origin());
+
+  const int nx = box.size(0);
+  const int ny = box.size(1);
+  const int nz = box.size(2);
+
+  for (int k = 0; k < nz; ++k)
+    for (int j = 0; j < ny; ++j)
+    {
+      const int row = first + j*stride[1] + k*stride[2];
+      const double* uc = u.data() + row;
+      double* yc = y.data() + row;
+
+      for (int i = 0; i < nx; ++i)
+      {
+        double v = 2.0*dim*uc[i];
+        if (i > 0)    v -= uc[i-1];
+        if (i < nx-1) v -= uc[i+1];
+        if (j > 0)    v -= uc[i-stride[1]];
+        if (j < ny-1) v -= uc[i+stride[1]];
+        if (k > 0)    v -= uc[i-stride[2]];
+        if (k < nz-1) v -= uc[i+stride[2]];
+        yc[i] = v;
+      }
+    }
+}
+
+int main (int argc, char** argv)
+{
+  const auto& mpiHelper = Dune::MPIHelper::instance(argc, argv);
+
+  const int n = (argc > 1) ? std::atoi(argv[1]) : 64;
+  const int repetitions = (argc > 2) ? std::atoi(argv[2]) : 10;
+
+  Dune::FieldVector<double,dim> len(1.0);
+  std::array<int,dim> s;
+  std::fill(s.begin(), s.end(), n);
+  Grid grid(len, s);
+
+  const auto gv = grid.leafGridView();
+  const auto bv = Dune::yaspBoxView(gv);
+
+  const std::size_t size = gv.size(0);
+  std::vector<double> u(size), yIterator(size), yBox(size);
+  for (std::size_t i = 0; i < size; ++i)
+    u[i] = std::sin(0.001*i);
+
+  Dune::Timer timer;
+  for (int r = 0; r < repetitions; ++r)
+    applyIterator(gv, u, yIterator);
+  const double tIterator = timer.elapsed() / repetitions;
+
+  timer.reset();
+  for (int r = 0; r < repetitions; ++r)
+    applyBox(bv, u, yBox);
+  const double tBox = timer.elapsed() / repetitions;
+
+  double error = 0.0;
+  for (std::size_t i = 0; i < size; ++i)
+    error = std::max(error, std::abs(yIterator[i] - yBox[i]));
+
+  if (mpiHelper.rank() == 0)
+  {
+    const double bytes = 2.0 * size * sizeof(double);
+    std::cout << "cells per rank:  " << size << std::endl;
+    std::cout << "iterator stencil: " << tIterator << " s ("
+              << bytes / tIterator * 1e-9 << " GB/s)" << std::endl;
+    std::cout << "box view stencil: " << tBox << " s ("
+              << bytes / tBox * 1e-9 << " GB/s)" << std::endl;
+    std::cout << "speedup:          " << tIterator / tBox << std::endl;
+    std::cout << "max difference:   " << error << std::endl;
+  }
+
+  return (error < 1e-12) ? 0 : 1;
+}
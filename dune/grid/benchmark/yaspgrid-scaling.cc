@@ -0,0 +1,153 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+/** \file
+ *  \brief Weak and strong scaling of the parallel operations of YaspGrid, reported as JSON
+ *
+ *  Times the construction of a 3d YaspGrid, the communication on all
+ *  interfaces and codimensions, globalRefine, and the construction of a
+ *  GlobalIndexSet for each codimension.  Communication is split into
+ *  packing (gather), unpacking (scatter), and the remaining time for setting
+ *  up and exchanging the messages.
+ *
+ *  For weak scaling, the grid has n*P x n x n elements on P processes, for
+ *  strong scaling n x n x n elements.
+ *
+ *  Usage: mpirun -np <P> yaspgrid-scaling [weak|strong] [n] [refinements] [output.json]
+ *
+ *  Without an output file, the report is written to the standard output.
+ */
+
+#include <config.h>
+
+#include <array>
+#include <bitset>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/yaspgrid.hh>
+#include <dune/grid/common/mcmgmapper.hh>
+#include <dune/grid/utility/globalindexset.hh>
+
+#include "scalingbenchmarks.hh"
+
+const int dim = 3;
+typedef Dune::YaspGrid<dim> Grid;
+typedef Grid::LeafGridView GridView;
+typedef Dune::MultipleCodimMultipleGeomTypeMapper<GridView> Mapper;
+
+const std::pair<Dune::InterfaceType, std::string> interfaces[] = {
+  { Dune::InteriorBorder_InteriorBorder_Interface, "InteriorBorder_InteriorBorder" },
+  { Dune::InteriorBorder_All_Interface, "InteriorBorder_All" },
+  { Dune::Overlap_OverlapFront_Interface, "Overlap_OverlapFront" },
+  { Dune::Overlap_All_Interface, "Overlap_All" },
+  { Dune::All_All_Interface, "All_All" }
+};
+
+// communicate one double per entity of each codimension on each interface
+void timeCommunication (Dune::Benchmark::ScalingReport& report, const Grid& grid, const std::string& prefix)
+{
+  const GridView gv = grid.leafGridView();
+
+  for (int codim = 0; codim <= dim; ++codim)
+  {
+    const Mapper mapper(gv, [codim] (Dune::GeometryType gt, int griddim) {
+        return griddim - int(gt.dim()) == codim;
+      });
+    std::vector<double> data(mapper.size(), 1.0);
+
+    for (const auto& interface : interfaces)
+    {
+      Dune::Benchmark::TimedDataHandle<Mapper> dataHandle(mapper, data, codim);
+      const double total = Dune::Benchmark::timeCollective(grid.comm(), [&] {
+          gv.communicate(dataHandle, interface.first, Dune::ForwardCommunication);
+        });
+
+      const std::string operation = prefix + "communicate codim " + std::to_string(codim) + " " + interface.second;
+      report.add(operation, "pack", dataHandle.packTime());
+      report.add(operation, "exchange", total - dataHandle.packTime() - dataHandle.unpackTime());
+      report.add(operation, "unpack", dataHandle.unpackTime());
+      report.add(operation, "total", total);
+    }
+  }
+}
+
+void timeGlobalIndexSets (Dune::Benchmark::ScalingReport& report, const Grid& grid, const std::string& prefix)
+{
+  const GridView gv = grid.leafGridView();
+  for (int codim = 0; codim <= dim; ++codim)
+  {
+    std::unique_ptr<Dune::GlobalIndexSet<GridView> > indexSet;
+    const double t = Dune::Benchmark::timeCollective(grid.comm(), [&] {
+        indexSet.reset(new Dune::GlobalIndexSet<GridView>(gv, codim));
+      });
+    report.add(prefix + "GlobalIndexSet codim " + std::to_string(codim), "setup", t);
+  }
+}
+
+int main (int argc, char** argv)
+{
+  const auto& mpiHelper = Dune::MPIHelper::instance(argc, argv);
+
+  const std::string mode = (argc > 1) ? argv[1] : "weak";
+  const int n = (argc > 2) ? std::atoi(argv[2]) : 32;
+  const int refinements = (argc > 3) ? std::atoi(argv[3]) : 1;
+  const std::string output = (argc > 4) ? argv[4] : "";
+
+  if (mode != "weak" && mode != "strong")
+    DUNE_THROW(Dune::Exception, "Unknown scaling mode '" << mode << "', use 'weak' or 'strong'");
+
+  const auto& comm = Dune::MPIHelper::getCollectiveCommunication();
+  const int P = mpiHelper.size();
+
+  std::array<int,dim> size;
+  size.fill(n);
+  Dune::FieldVector<double,dim> upper(1.0);
+  if (mode == "weak")
+  {
+    size[0] *= P;
+    upper[0] *= P;
+  }
+
+  Dune::Benchmark::ScalingReport report(mode, n);
+
+  std::unique_ptr<Grid> grid;
+  report.add("construction", "setup", Dune::Benchmark::timeCollective(comm, [&] {
+        grid.reset(new Grid(upper, size, std::bitset<dim>(0ULL), 1));
+      }));
+
+  timeCommunication(report, *grid, "");
+  timeGlobalIndexSets(report, *grid, "");
+
+  for (int r = 1; r <= refinements; ++r)
+  {
+    report.add("globalRefine to level " + std::to_string(r), "setup", Dune::Benchmark::timeCollective(comm, [&] {
+          grid->globalRefine(1);
+        }));
+
+    const std::string prefix = "level " + std::to_string(r) + " ";
+    timeCommunication(report, *grid, prefix);
+    timeGlobalIndexSets(report, *grid, prefix);
+  }
+
+  if (output.empty())
+    report.write(std::cout, comm);
+  else
+  {
+    std::ofstream file;
+    if (mpiHelper.rank() == 0)
+      file.open(output);
+    report.write(file, comm);
+  }
+
+  return 0;
+}
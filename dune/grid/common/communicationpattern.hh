@@ -0,0 +1,343 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_COMMON_COMMUNICATIONPATTERN_HH
+#define DUNE_GRID_COMMON_COMMUNICATIONPATTERN_HH
+
+/** \file
+ *  \brief The entities a grid view exchanges with the other processes, computed once
+ *
+ *  Each call of GridView::communicate() determines the entities to send and
+ *  to receive anew; UGGrid, e.g., searches its DDD interfaces, and the data
+ *  is packed entity by entity through the data handle.  A
+ *  CommunicationPattern asks the grid for the entities of an interface and a
+ *  codimension once and stores them as flat index arrays per neighbor
+ *  process.  Vectors indexed by a mapper can then be exchanged with a plain
+ *  copy into a message buffer per neighbor.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if HAVE_MPI
+#include <mpi.h>
+#endif
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/parallel/collectivecommunication.hh>
+
+#include <dune/geometry/type.hh>
+
+#include <dune/grid/common/datahandleif.hh>
+#include <dune/grid/common/exceptions.hh>
+#include <dune/grid/common/gridenums.hh>
+#include <dune/grid/common/mcmgmapper.hh>
+
+namespace Dune
+{
+
+  namespace Impl {
+
+#if HAVE_MPI
+    // the MPI communicator of a grid, MPI_COMM_SELF for sequential grids
+    inline MPI_Comm communicationPatternComm (const CollectiveCommunication<MPI_Comm>& comm)
+    {
+      return comm;
+    }
+
+    template<class Comm>
+    MPI_Comm communicationPatternComm (const Comm&)
+    {
+      return MPI_COMM_SELF;
+    }
+#endif
+
+  } // namespace Impl
+
+  /** \brief The send and receive lists of a grid view for each interface and codimension
+   *
+   *  The entities of a codimension are numbered by a
+   *  MultipleCodimMultipleGeomTypeMapper with a layout containing all entities
+   *  of that codimension, see mapper().  For each neighbor process, the
+   *  pattern stores the indices of the entities sent to it and received from
+   *  it.  Both processes order the entities they exchange by the index on the
+   *  sending process, so the messages need no further information.
+   *
+   *  The lists of an interface and codimension are computed by two calls of
+   *  GridView::communicate() the first time they are used.  After a
+   *  modification of the grid, update() has to be called.
+   *
+   *  \note The methods that compute or use the lists are collective on the
+   *        communicator of the grid view.
+   *
+   *  \tparam GV The grid view
+   */
+  template<class GV>
+  class CommunicationPattern
+  {
+  public:
+    typedef GV GridView;
+
+    static const int dimension = GridView::dimension;
+
+    typedef MultipleCodimMultipleGeomTypeMapper<GridView> Mapper;
+    typedef typename Mapper::Index Index;
+
+    //! The entities exchanged with each neighbor process in one direction
+    struct Lists
+    {
+      //! the neighbor processes, sorted
+      std::vector<int> ranks;
+      //! the entities of ranks[i] are indices[offsets[i]], ..., indices[offsets[i+1]-1]
+      std::vector<std::size_t> offsets = std::vector<std::size_t>(1, 0);
+      //! the local indices of the entities
+      std::vector<Index> indices;
+    };
+
+    //! The lists of one interface and codimension, for forward communication
+    struct Interface
+    {
+      Lists send;
+      Lists recv;
+    };
+
+    //! The MPI tag of the messages of exchange() if no other one is given
+    static const int defaultTag = 2017;
+
+    /** \brief Create the pattern of a grid view, the lists are computed on first use
+     *
+     *  \param gridView The grid view
+     *  \param tag      The MPI tag of the messages of exchange()
+     */
+    explicit CommunicationPattern (const GridView& gridView, int tag = defaultTag)
+      : gridView_(gridView), tag_(tag)
+    {}
+
+    //! Forget all lists and mappers, this has to be called after each modification of the grid
+    void update ()
+    {
+      interfaces_.clear();
+      for (auto& mapper : mappers_)
+        mapper.reset();
+    }
+
+    //! The mapper numbering the entities of a codimension
+    const Mapper& mapper (int codim) const
+    {
+      assert((codim >= 0) && (codim <= dimension));
+      if (!mappers_[codim])
+        mappers_[codim].reset(new Mapper(gridView_, [codim] (GeometryType gt, int dim) {
+              return gt.dim() == dim - codim;
+            }));
+      return *mappers_[codim];
+    }
+
+    //! The lists of an interface and codimension, they are computed on first use
+    const Interface& interface (InterfaceType iftype, int codim) const
+    {
+      const auto key = std::make_pair(int(iftype), codim);
+      auto it = interfaces_.find(key);
+      if (it == interfaces_.end())
+        it = interfaces_.emplace(key, build(iftype, codim)).first;
+      return it->second;
+    }
+
+    /** \brief Exchange the data of the entities of an interface and codimension
+     *
+     *  Each received value is combined with the value of the receiving entity,
+     *  data[i] = combine(data[i], received).
+     *
+     *  \param data   The data, indexed by mapper(codim); the value type has to be trivially copyable
+     *  \param iftype The interface
+     *  \param dir    The direction of the communication
+     *  \param codim  The codimension of the entities
+     *  \param combine Combines the value of an entity with a received one
+     */
+    template<class Vector, class Combine>
+    void exchange (Vector& data, InterfaceType iftype, CommunicationDirection dir, int codim, Combine combine) const
+    {
+      typedef typename std::decay<decltype(data[0])>::type T;
+      static_assert(std::is_trivially_copyable<T>::value, "CommunicationPattern can only exchange trivially copyable data");
+
+      const Interface& pattern = interface(iftype, codim);
+      const Lists& send = (dir == ForwardCommunication) ? pattern.send : pattern.recv;
+      const Lists& recv = (dir == ForwardCommunication) ? pattern.recv : pattern.send;
+
+      std::vector<T> sendBuffer(send.indices.size());
+      std::vector<T> recvBuffer(recv.indices.size());
+      for (std::size_t k = 0; k < send.indices.size(); ++k)
+        sendBuffer[k] = data[send.indices[k]];
+
+      const int rank = gridView_.comm().rank();
+#if HAVE_MPI
+      // the messages are split into pieces whose size fits into the int count of MPI,
+      // the pieces from one process arrive in the order they were sent
+      const MPI_Comm comm = Impl::communicationPatternComm(gridView_.comm());
+      const std::size_t maxPiece = std::numeric_limits<int>::max();
+      std::vector<MPI_Request> requests;
+      requests.reserve(send.ranks.size() + recv.ranks.size());
+      for (std::size_t i = 0; i < recv.ranks.size(); ++i)
+        if (recv.ranks[i] != rank)
+        {
+          char* message = reinterpret_cast<char*>(recvBuffer.data() + recv.offsets[i]);
+          const std::size_t bytes = (recv.offsets[i+1] - recv.offsets[i])*sizeof(T);
+          for (std::size_t begin = 0; begin < bytes; begin += maxPiece)
+          {
+            requests.emplace_back();
+            MPI_Irecv(message + begin, int(std::min(maxPiece, bytes - begin)), MPI_BYTE,
+                      recv.ranks[i], tag_, comm, &requests.back());
+          }
+        }
+      for (std::size_t i = 0; i < send.ranks.size(); ++i)
+        if (send.ranks[i] != rank)
+        {
+          char* message = reinterpret_cast<char*>(sendBuffer.data() + send.offsets[i]);
+          const std::size_t bytes = (send.offsets[i+1] - send.offsets[i])*sizeof(T);
+          for (std::size_t begin = 0; begin < bytes; begin += maxPiece)
+          {
+            requests.emplace_back();
+            MPI_Isend(message + begin, int(std::min(maxPiece, bytes - begin)), MPI_BYTE,
+                      send.ranks[i], tag_, comm, &requests.back());
+          }
+        }
+#endif
+
+      // the messages to this process itself, e.g., at periodic boundaries
+      const auto sendSelf = std::lower_bound(send.ranks.begin(), send.ranks.end(), rank);
+      const auto recvSelf = std::lower_bound(recv.ranks.begin(), recv.ranks.end(), rank);
+      const bool hasSendSelf = (sendSelf != send.ranks.end()) && (*sendSelf == rank);
+      const bool hasRecvSelf = (recvSelf != recv.ranks.end()) && (*recvSelf == rank);
+      if (hasSendSelf != hasRecvSelf)
+        DUNE_THROW(GridError, "CommunicationPattern: sends and receives of rank " << rank << " to itself do not match");
+      if (hasSendSelf)
+      {
+        const std::size_t i = sendSelf - send.ranks.begin();
+        const std::size_t j = recvSelf - recv.ranks.begin();
+        if (send.offsets[i+1] - send.offsets[i] != recv.offsets[j+1] - recv.offsets[j])
+          DUNE_THROW(GridError, "CommunicationPattern: sends and receives of rank " << rank << " to itself do not match");
+        std::copy(sendBuffer.begin() + send.offsets[i], sendBuffer.begin() + send.offsets[i+1],
+                  recvBuffer.begin() + recv.offsets[j]);
+      }
+
+#if HAVE_MPI
+      MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+#endif
+
+      for (std::size_t k = 0; k < recv.indices.size(); ++k)
+        data[recv.indices[k]] = combine(data[recv.indices[k]], recvBuffer[k]);
+    }
+
+    /** \brief Exchange the data of the entities of an interface and codimension
+     *
+     *  The received values overwrite the values of the receiving entities.
+     */
+    template<class Vector>
+    void exchange (Vector& data, InterfaceType iftype, CommunicationDirection dir, int codim) const
+    {
+      exchange(data, iftype, dir, codim, [] (const auto&, const auto& received) { return received; });
+    }
+
+    const GridView& gridView () const
+    {
+      return gridView_;
+    }
+
+  private:
+    // (rank of the other process, index on the sending process, index on the receiving process)
+    typedef std::array<std::size_t, 3> Link;
+
+    // records for each entity on the receiving side the rank and index of the sender
+    class LinkHandle
+      : public CommDataHandleIF<LinkHandle, std::size_t>
+    {
+    public:
+      LinkHandle (const Mapper& mapper, int codim, int rank, bool sendSide, std::vector<Link>& links)
+        : mapper_(mapper), codim_(codim), rank_(rank), sendSide_(sendSide), links_(links)
+      {}
+
+      bool contains (int, int codim) const { return codim == codim_; }
+      bool fixedSize (int, int) const { return true; }
+
+      template<class Entity>
+      std::size_t size (const Entity&) const { return 2; }
+
+      template<class Buffer, class Entity>
+      void gather (Buffer& buffer, const Entity& entity) const
+      {
+        buffer.write(std::size_t(rank_));
+        buffer.write(std::size_t(mapper_.index(entity)));
+      }
+
+      template<class Buffer, class Entity>
+      void scatter (Buffer& buffer, const Entity& entity, std::size_t)
+      {
+        std::size_t rank, other;
+        buffer.read(rank);
+        buffer.read(other);
+        const std::size_t mine = mapper_.index(entity);
+        if (sendSide_)
+          links_.push_back({{rank, mine, other}});
+        else
+          links_.push_back({{rank, other, mine}});
+      }
+
+    private:
+      const Mapper& mapper_;
+      int codim_;
+      int rank_;
+      bool sendSide_;
+      std::vector<Link>& links_;
+    };
+
+    Interface build (InterfaceType iftype, int codim) const
+    {
+      const int rank = gridView_.comm().rank();
+
+      // the receivers learn their senders by a forward communication,
+      // the senders their receivers by a backward communication
+      std::vector<Link> sendLinks, recvLinks;
+      LinkHandle forward(mapper(codim), codim, rank, false, recvLinks);
+      gridView_.communicate(forward, iftype, ForwardCommunication);
+      LinkHandle backward(mapper(codim), codim, rank, true, sendLinks);
+      gridView_.communicate(backward, iftype, BackwardCommunication);
+
+      Interface result;
+      fill(result.send, sendLinks, 1);
+      fill(result.recv, recvLinks, 2);
+      return result;
+    }
+
+    // sort the links by rank and sending index and store the local indices
+    static void fill (Lists& lists, std::vector<Link>& links, int local)
+    {
+      std::sort(links.begin(), links.end());
+      for (std::size_t k = 0; k < links.size(); ++k)
+      {
+        if (lists.ranks.empty() || std::size_t(lists.ranks.back()) != links[k][0])
+        {
+          if (!lists.ranks.empty())
+            lists.offsets.push_back(k);
+          lists.ranks.push_back(links[k][0]);
+        }
+        lists.indices.push_back(links[k][local]);
+      }
+      if (!lists.ranks.empty())
+        lists.offsets.push_back(links.size());
+    }
+
+    GridView gridView_;
+    int tag_;
+    mutable std::array<std::unique_ptr<Mapper>, dimension+1> mappers_;
+    mutable std::map<std::pair<int, int>, Interface> interfaces_;
+  };
+
+} // namespace Dune
+
+#endif // DUNE_GRID_COMMON_COMMUNICATIONPATTERN_HH
@@ -7,6 +7,8 @@
     \brief Provide a generic factory class for unstructured grids.
  */
 
+#include <algorithm>
+#include <cstddef>
 #include <memory>
 #include <vector>
 
@@ -15,6 +17,7 @@
 #include <dune/common/to_unique_ptr.hh>
 #include <dune/common/parallel/mpihelper.hh>
 
+#include <dune/geometry/referenceelements.hh>
 #include <dune/geometry/type.hh>
 
 #include <dune/grid/common/boundarysegment.hh>
@@ -107,6 +110,69 @@ namespace Dune
     virtual void insertElement(const GeometryType& type,
                                const std::vector<unsigned int>& vertices) = 0;
 
+    /** \brief Reserve memory for the coarse grid to be inserted
+
+        This is only a hint; inserting more or fewer vertices and elements is allowed.
+
+        \param numVertices The number of vertices that will be inserted
+        \param numElements The number of elements that will be inserted
+     */
+    virtual void reserve(std::size_t /* numVertices */, std::size_t /* numElements */)
+    {}
+
+    /** \brief Insert several vertices into the coarse grid at once
+        \param coordinates The dimworld coordinates of each vertex, one vertex after the other
+        \param numVertices The number of vertices
+
+        The vertices are numbered consecutively, in the order given.
+     */
+    virtual void insertVertices(const ctype* coordinates, std::size_t numVertices)
+    {
+      FieldVector<ctype,dimworld> pos;
+      for (std::size_t i=0; i<numVertices; i++)
+      {
+        std::copy(coordinates + i*dimworld, coordinates + (i+1)*dimworld, pos.begin());
+        insertVertex(pos);
+      }
+    }
+
+    /** \brief Insert several elements of the same type into the coarse grid at once
+        \param type The GeometryType of all new elements
+        \param vertices The vertices of each element, using the DUNE numbering, one element after the other
+        \param numElements The number of elements
+
+        Make sure the inserted elements are not inverted (this holds even
+        for simplices).  There are grids that can't handle inverted elements.
+     */
+    virtual void insertElements(const GeometryType& type, const unsigned int* vertices, std::size_t numElements)
+    {
+      const std::size_t numCorners = ReferenceElements<ctype,dimension>::general(type).size(dimension);
+      std::vector<unsigned int> corners(numCorners);
+      for (std::size_t i=0; i<numElements; i++)
+      {
+        std::copy(vertices + i*numCorners, vertices + (i+1)*numCorners, corners.begin());
+        insertElement(type, corners);
+      }
+    }
+
+    /** \brief Insert several elements of possibly different types into the coarse grid at once
+        \param types The GeometryType of each element
+        \param vertices The vertices of all elements, using the DUNE numbering, one element after the other
+        \param offsets The vertices of element i are vertices[offsets[i]], ..., vertices[offsets[i+1]-1];
+                       this array has numElements+1 entries
+        \param numElements The number of elements
+     */
+    virtual void insertElements(const GeometryType* types, const unsigned int* vertices,
+                                const std::size_t* offsets, std::size_t numElements)
+    {
+      std::vector<unsigned int> corners;
+      for (std::size_t i=0; i<numElements; i++)
+      {
+        corners.assign(vertices + offsets[i], vertices + offsets[i+1]);
+        insertElement(types[i], corners);
+      }
+    }
+
     /** \brief Insert a parametrized element into the coarse grid
         \param type The GeometryType of the new element
         \param vertices The vertices of the new element, using the DUNE numbering
@@ -4,8 +4,11 @@
 #ifndef DUNE_GRID_COMMON_INDEXIDSET_HH
 #define DUNE_GRID_COMMON_INDEXIDSET_HH
 
+#include <utility>
 #include <vector>
 #include <dune/common/exceptions.hh>
+#include <dune/common/reservedvector.hh>
+#include <dune/common/typeutilities.hh>
 #include <dune/grid/common/grid.hh>
 
 
@@ -19,6 +22,26 @@ namespace Dune
 
 #include <dune/common/bartonnackmanifcheck.hh>
 
+  namespace Impl {
+
+    /* The maximal number of subentities of a single codimension of a
+     * dim-dimensional element.  The cube has the most, binomial(dim,c)*2^c
+     * in codimension c.
+     */
+    constexpr int maxSubEntities (int dim)
+    {
+      int result = 1;
+      int binomial = 1;
+      for (int c = 0; c <= dim; ++c)
+      {
+        result = (binomial << c) > result ? (binomial << c) : result;
+        binomial = binomial * (dim-c) / (c+1);
+      }
+      return result;
+    }
+
+  } // namespace Impl
+
   /** @brief Index Set %Interface base class.
 
      This class template is used as a base class for all index set implementations.
@@ -95,6 +118,9 @@ namespace Dune
     /** \brief dimension of the grid (maximum allowed codimension) */
     static const int dimension = std::remove_const< GridImp >::type::dimension;
 
+    /** \brief Buffer for the indices of all subentities of one codimension of an entity */
+    typedef ReservedVector< IndexType, Impl::maxSubEntities( dimension ) > SubIndices;
+
     //===========================================================
     /** @name Index access from entity
      */
@@ -182,6 +208,29 @@ namespace Dune
       static const int cc = Entity::codimension;
       return asImp().template subIndex< cc >( e, i, codim );
     }
+
+    /** \brief Map all subentities of a codimension to their indices.
+     *
+     *  The i-th entry of the result is subIndex( e, i, codim ).  Index sets
+     *  that can share work between the subentities, e.g., looking up the
+     *  element or its reference element, implement
+     *  <tt>template< int cc > subIndices( e, codim )</tt>.  Otherwise,
+     *  subIndex() is called for each subentity.
+     *
+     *  \param[in]  e      reference to entity
+     *  \param[in]  codim  codimension of the subentities we're interested in
+     *
+     *  \note The parameter <tt>codim</tt> denotes the codimension with respect
+     *        to the grid, i.e., it must satisfy cc <= codim <= dimension.
+     *
+     *  \return The indices of all subentities of e of codimension codim.
+     */
+    template< class Entity >
+    SubIndices subIndices ( const Entity &e, unsigned int codim ) const
+    {
+      static const int cc = Entity::codimension;
+      return subIndicesImpl< cc >( e, codim, PriorityTag< 1 >() );
+    }
     //@}
 
 
@@ -257,6 +306,26 @@ namespace Dune
     //! Forbid the assignment operator
     IndexSet& operator=(const IndexSet&) = delete;
 
+    // forward to the implementation if it provides subIndices for this codimension
+    template< int cc, class Entity >
+    auto subIndicesImpl ( const Entity &e, unsigned int codim, PriorityTag< 1 > ) const
+      -> decltype( std::declval< const IndexSetImp & >().template subIndices< cc >( e, codim ) )
+    {
+      return asImp().template subIndices< cc >( e, codim );
+    }
+
+    // otherwise, e.g., for index sets not derived from IndexSetDefaultImplementation
+    template< int cc, class Entity >
+    SubIndices subIndicesImpl ( const Entity &e, unsigned int codim, PriorityTag< 0 > ) const
+    {
+      SubIndices result;
+      const unsigned int size = e.subEntities( codim );
+      result.resize( size );
+      for( unsigned int i = 0; i < size; ++i )
+        result[ i ] = asImp().template subIndex< cc >( e, i, codim );
+      return result;
+    }
+
     //!  Barton-Nackman trick
     IndexSetImp& asImp () {return static_cast<IndexSetImp &> (*this);}
     //!  Barton-Nackman trick
@@ -289,6 +358,23 @@ namespace Dune
 
     using Base::index;
     using Base::subIndex;
+    using Base::subIndices;
+
+    /** \brief Map all subentities of a codimension of an entity to their indices
+     *
+     *  Calls subIndex() for each subentity.  Derived index sets can provide a
+     *  faster implementation.
+     */
+    template< int cc >
+    typename Base::SubIndices subIndices ( const typename Traits::template Codim< cc >::Entity &e, unsigned int codim ) const
+    {
+      typename Base::SubIndices result;
+      const unsigned int size = e.subEntities( codim );
+      result.resize( size );
+      for( unsigned int i = 0; i < size; ++i )
+        result[ i ] = asImp().template subIndex< cc >( e, i, codim );
+      return result;
+    }
 
     //===========================================================
     /** @name Access to entity set
@@ -0,0 +1,264 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_COMMON_INSTRUMENTATION_HH
+#define DUNE_GRID_COMMON_INSTRUMENTATION_HH
+
+/** \file
+ *  \brief Counters and timers for the expensive collective operations of the grids
+ *
+ *  The grids record the number of calls, the time, and the number of bytes sent
+ *  or written for communicate, adapt, loadBalance and VTKWriter::write, broken
+ *  down by operation, codimension and interface.  The records are kept per
+ *  process and can be queried with Instrumentation::registry() or written as JSON.
+ *
+ *  The instrumentation is compiled in only if the preprocessor symbol
+ *  DUNE_GRID_INSTRUMENTATION is defined to 1, e.g., by adding
+ *  -DDUNE_GRID_INSTRUMENTATION=1 to the compiler flags.  Otherwise the macros
+ *  DUNE_GRID_INSTRUMENT_REGION and DUNE_GRID_INSTRUMENT_BYTES expand to nothing
+ *  and their arguments are not evaluated.  The regions in the dune-grid library
+ *  itself (adapt and loadBalance of UGGrid, adapt of OneDGrid) are only
+ *  recorded if the library was compiled with the flag as well.
+ *
+ *  Each instrumented region can additionally be marked for an external
+ *  profiler: either with Intel ITT tasks, if DUNE_GRID_INSTRUMENTATION_ITT is
+ *  defined to 1 and ittnotify is available, or through callbacks installed with
+ *  Instrumentation::Registry::setMarkers(), which can forward the regions to
+ *  perf, NVTX or any other tool.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <tuple>
+
+#include <dune/grid/common/gridenums.hh>
+
+#ifndef DUNE_GRID_INSTRUMENTATION
+#define DUNE_GRID_INSTRUMENTATION 0
+#endif
+
+#if DUNE_GRID_INSTRUMENTATION_ITT
+#include <ittnotify.h>
+#endif
+
+namespace Dune
+{
+  namespace Instrumentation
+  {
+
+    //! Identifies a record: the operation, and the codimension and interface if they apply, -1 otherwise
+    struct Key
+    {
+      std::string operation;
+      int codim;
+      int interface;
+
+      bool operator< (const Key& other) const
+      {
+        return std::tie(operation, codim, interface) < std::tie(other.operation, other.codim, other.interface);
+      }
+    };
+
+    //! The accumulated counters of one record
+    struct Counters
+    {
+      std::size_t calls = 0;
+      std::size_t bytes = 0;
+      double seconds = 0.0;
+    };
+
+    /** \brief Holds the records of all instrumented regions of this process
+     *
+     * All methods are thread-safe.
+     */
+    class Registry
+    {
+    public:
+      typedef void (*Marker)(const char* operation);
+
+      //! Add one call of a region to its record
+      void record (const char* operation, int codim, int interface, double seconds, std::size_t bytes)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Counters& counters = records_[Key{operation, codim, interface}];
+        ++counters.calls;
+        counters.bytes += bytes;
+        counters.seconds += seconds;
+      }
+
+      //! The record of an operation; the counters are zero if it was never called
+      Counters counters (const std::string& operation, int codim = -1, int interface = -1) const
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = records_.find(Key{operation, codim, interface});
+        return (it != records_.end()) ? it->second : Counters();
+      }
+
+      //! A copy of all records
+      std::map<Key, Counters> records () const
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return records_;
+      }
+
+      //! Forget all records
+      void reset ()
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        records_.clear();
+      }
+
+      /** \brief Write all records as JSON
+       *
+       * The format is <tt>{"regions": [{"operation": ..., "codim": ...,
+       * "interface": ..., "calls": ..., "seconds": ..., "bytes": ...}, ...]}</tt>,
+       * where codim and interface are null if they do not apply.
+       */
+      void write (std::ostream& out) const
+      {
+        const auto all = records();
+        out << "{\n  \"regions\": [";
+        bool first = true;
+        for (const auto& record : all)
+        {
+          out << (first ? "" : ",") << "\n    {"
+              << "\"operation\": \"" << record.first.operation << "\", "
+              << "\"codim\": ";
+          if (record.first.codim < 0)
+            out << "null";
+          else
+            out << record.first.codim;
+          out << ", \"interface\": ";
+          if (record.first.interface < 0)
+            out << "null";
+          else
+            out << "\"" << InterfaceType(record.first.interface) << "\"";
+          out << ", \"calls\": " << record.second.calls
+              << ", \"seconds\": " << record.second.seconds
+              << ", \"bytes\": " << record.second.bytes << "}";
+          first = false;
+        }
+        out << "\n  ]\n}" << std::endl;
+      }
+
+      /** \brief Install callbacks called when a region begins and ends
+       *
+       * Pass null pointers to remove them.
+       */
+      void setMarkers (Marker begin, Marker end)
+      {
+        begin_ = begin;
+        end_ = end;
+      }
+
+      //! Called by Region when it begins
+      void beginMarker (const char* operation)
+      {
+#if DUNE_GRID_INSTRUMENTATION_ITT
+        __itt_task_begin(ittDomain(), __itt_null, __itt_null, __itt_string_handle_create(operation));
+#endif
+        if (Marker begin = begin_)
+          begin(operation);
+      }
+
+      //! Called by Region when it ends
+      void endMarker (const char* operation)
+      {
+        if (Marker end = end_)
+          end(operation);
+#if DUNE_GRID_INSTRUMENTATION_ITT
+        __itt_task_end(ittDomain());
+#endif
+      }
+
+    private:
+#if DUNE_GRID_INSTRUMENTATION_ITT
+      static __itt_domain* ittDomain ()
+      {
+        static __itt_domain* domain = __itt_domain_create("dune-grid");
+        return domain;
+      }
+#endif
+
+      mutable std::mutex mutex_;
+      std::map<Key, Counters> records_;
+      std::atomic<Marker> begin_{nullptr};
+      std::atomic<Marker> end_{nullptr};
+    };
+
+    //! The registry of this process
+    inline Registry& registry ()
+    {
+      static Registry instance;
+      return instance;
+    }
+
+    /** \brief Times a region from its construction to its destruction and records it in the registry
+     *
+     * Use it through the macro DUNE_GRID_INSTRUMENT_REGION, such that it
+     * can be compiled out.
+     *
+     * \note The operation name has to outlive the region, use a string literal.
+     */
+    class Region
+    {
+      typedef std::chrono::steady_clock Clock;
+
+    public:
+      explicit Region (const char* operation, int codim = -1, int interface = -1)
+        : operation_(operation), codim_(codim), interface_(interface), bytes_(0)
+      {
+        registry().beginMarker(operation_);
+        start_ = Clock::now();
+      }
+
+      Region (const char* operation, int codim, InterfaceType interface)
+        : Region(operation, codim, int(interface))
+      {}
+
+      Region (const Region&) = delete;
+      Region& operator= (const Region&) = delete;
+
+      ~Region ()
+      {
+        const double seconds = std::chrono::duration<double>(Clock::now() - start_).count();
+        registry().endMarker(operation_);
+        registry().record(operation_, codim_, interface_, seconds, bytes_);
+      }
+
+      //! Count bytes sent or written by this process in the region
+      void addBytes (std::size_t bytes)
+      {
+        bytes_ += bytes;
+      }
+
+    private:
+      const char* operation_;
+      int codim_;
+      int interface_;
+      std::size_t bytes_;
+      Clock::time_point start_;
+    };
+
+  } // namespace Instrumentation
+
+} // namespace Dune
+
+#if DUNE_GRID_INSTRUMENTATION
+/** \brief Declare an Instrumentation::Region with the given name in the current scope
+ *
+ * The further arguments are those of the constructor of Instrumentation::Region.
+ */
+#define DUNE_GRID_INSTRUMENT_REGION(name, ...) ::Dune::Instrumentation::Region name(__VA_ARGS__)
+//! Add bytes to the region with the given name
+#define DUNE_GRID_INSTRUMENT_BYTES(name, bytes) (name).addBytes(bytes)
+#else
+#define DUNE_GRID_INSTRUMENT_REGION(name, ...)
+#define DUNE_GRID_INSTRUMENT_BYTES(name, bytes)
+#endif
+
+#endif // DUNE_GRID_COMMON_INSTRUMENTATION_HH
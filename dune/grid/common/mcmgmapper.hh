@@ -15,6 +15,8 @@
 #include <dune/geometry/type.hh>
 #include <dune/geometry/typeindex.hh>
 
+#include <dune/grid/common/capabilities.hh>
+
 #include "mapper.hh"
 
 /**
@@ -88,6 +90,19 @@ namespace Dune
         { DUNE_THROW(Exception, "The default layout class cannot be used"); }
     };
 
+    /*
+     * Whether all entities of a codimension have the same geometry type in
+     * every grid view of the grid: the grid has a single element type, which
+     * is a simplex or a cube.  Bit 0 of the topology id does not matter.
+     */
+    template<class Grid>
+    constexpr bool hasSingleSubEntityTypes ()
+    {
+      return Capabilities::hasSingleGeometryType<Grid>::v
+             && (((Capabilities::hasSingleGeometryType<Grid>::topologyId >> 1) == 0)
+                 || ((Capabilities::hasSingleGeometryType<Grid>::topologyId >> 1) == ((1u << Grid::dimension) - 1) >> 1));
+    }
+
   } /* namespace Impl */
 
   /**
@@ -193,6 +208,14 @@ namespace Dune
    *                The MultipleCodimMultipleGeomTypeMapper will always
    *                substitute the dimension of the grid for the template
    *                parameter dimgrid.
+   *
+   * If all entities of a codimension have the same geometry type, the
+   * mapper determines the offset and the block size of these entities by the
+   * codimension and does not look at the geometry type of the entity.  For
+   * grids with a single simplex or cube element type, this is known at
+   * compile time (see singleGeometryType).  It does not follow from a single
+   * element type alone: prisms and pyramids, e.g., have triangle and
+   * quadrilateral faces.
    */
   template <typename GV, template<int> class LayoutClass = Impl::MCMGFailLayout>
   class MultipleCodimMultipleGeomTypeMapper :
@@ -212,6 +235,16 @@ namespace Dune
      */
     using size_type = decltype(std::declval<typename GV::IndexSet>().size(0));
 
+    /** \brief Whether all entities of each codimension have the same geometry type, known at compile time
+     *
+     * This is the case if all elements of the grid are simplices or all are
+     * cubes (Capabilities::hasSingleGeometryType).
+     */
+    static const bool singleGeometryType = Impl::hasSingleSubEntityTypes<typename GV::Grid>();
+
+    /** \brief Buffer for the indices of all subentities of a codimension of an element */
+    typedef typename GV::IndexSet::SubIndices SubEntityIndices;
+
     /** @brief Construct mapper from grid and one of its index sets.
      *
      * \param gridView A Dune GridView object.
@@ -253,6 +286,12 @@ namespace Dune
     template<class EntityType>
     Index index (const EntityType& e) const
     {
+      const int codim = EntityType::codimension;
+      if (singleGeometryType || uniformCodim_[codim])
+      {
+        assert(codimOffsets_[codim] != invalidOffset);
+        return is.index(e)*codimBlocks_[codim] + codimOffsets_[codim];
+      }
       const GeometryType gt = e.type();
       assert(offset(gt) != invalidOffset);
       return is.index(e)*blockSize(gt) + offset(gt);
@@ -267,6 +306,11 @@ namespace Dune
      */
     Index subIndex (const typename GV::template Codim<0>::Entity& e, int i, unsigned int codim) const
     {
+      if (singleGeometryType || uniformCodim_[codim])
+      {
+        assert(codimOffsets_[codim] != invalidOffset);
+        return is.subIndex(e, i, codim)*codimBlocks_[codim] + codimOffsets_[codim];
+      }
       const GeometryType eType = e.type();
       GeometryType gt = eType.isNone() ?
         GeometryTypes::none( GV::dimension - codim ) :
@@ -276,6 +320,46 @@ namespace Dune
       return is.subIndex(e, i, codim)*blockSize(gt) + offset(gt);
     }
 
+    /** @brief Map all subentities of a codimension of a codim 0 entity to the starting indices of their dof blocks
+
+       All subentities of this codimension have to be in the domain of the map.
+
+       \param e Reference to codim 0 entity.
+       \param codim Codimension of the subentities
+       \return The indices, the i-th entry is subIndex(e, i, codim)
+     */
+    SubEntityIndices subIndices (const typename GV::template Codim<0>::Entity& e, unsigned int codim) const
+    {
+      SubEntityIndices result = is.subIndices(e, codim);
+      const GeometryType eType = e.type();
+      if (singleGeometryType || uniformCodim_[codim])
+      {
+        const Index block = codimBlocks_[codim];
+        const Index start = codimOffsets_[codim];
+        assert(start != invalidOffset);
+        for (Index& i : result)
+          i = i*block + start;
+      }
+      else if (eType.isNone())
+      {
+        const GeometryType gt = GeometryTypes::none(GV::dimension - codim);
+        assert(offset(gt) != invalidOffset);
+        for (Index& i : result)
+          i = i*blockSize(gt) + offset(gt);
+      }
+      else
+      {
+        const auto refElement = ReferenceElements<double,GV::dimension>::general(eType);
+        for (std::size_t i = 0; i < result.size(); ++i)
+        {
+          const GeometryType gt = refElement.type(i, codim);
+          assert(offset(gt) != invalidOffset);
+          result[i] = result[i]*blockSize(gt) + offset(gt);
+        }
+      }
+      return result;
+    }
+
     /** @brief Return total number of entities in the entity set managed by the mapper.
 
        This number can be used to allocate a vector of data elements associated with the
@@ -392,9 +476,14 @@ namespace Dune
 
       std::fill(offsets.begin(),offsets.end(),Index(0));
       std::fill(blocks.begin(),blocks.end(),Index(0));
+      std::fill(codimOffsets_.begin(),codimOffsets_.end(),invalidOffset);
+      std::fill(codimBlocks_.begin(),codimBlocks_.end(),Index(0));
+      std::fill(uniformCodim_.begin(),uniformCodim_.end(),false);
 
       for (unsigned int codim = 0; codim <= GV::dimension; ++codim)
       {
+        myTypes_[codim].clear();
+
         // walk over all geometry types in the codimension
         for (const GeometryType& gt : is.types(codim)) {
           Index offset;
@@ -414,6 +503,15 @@ namespace Dune
           offsets[GlobalGeometryTypeIndex::index(gt)] = offset;
           blocks[GlobalGeometryTypeIndex::index(gt)] = block;
         }
+
+        // a codimension with a single geometry type is mapped without looking at the type
+        if (is.types(codim).size() == 1)
+        {
+          const GeometryType gt = is.types(codim)[0];
+          codimOffsets_[codim] = offset(gt);
+          codimBlocks_[codim] = blockSize(gt);
+          uniformCodim_[codim] = true;
+        }
       }
     }
 
@@ -436,6 +534,10 @@ namespace Dune
     // provide an array for the offsets
     std::array<Index, GlobalGeometryTypeIndex::size(GV::dimension)> offsets;
     std::array<Index, GlobalGeometryTypeIndex::size(GV::dimension)> blocks;
+    // the offset and block size of each codimension, only used if all its entities have the same geometry type
+    std::array<Index, GV::dimension+1> codimOffsets_;
+    std::array<Index, GV::dimension+1> codimBlocks_;
+    std::array<bool, GV::dimension+1> uniformCodim_;
     const MCMGLayout layout_;     // get layout object
     std::vector<GeometryType> myTypes_[GV::dimension+1];
 
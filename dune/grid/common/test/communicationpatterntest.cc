@@ -0,0 +1,138 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+/** \file
+    \brief A unit test for the CommunicationPattern
+ */
+
+#include <config.h>
+
+#include <bitset>
+#include <functional>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/test/testsuite.hh>
+
+#include <dune/grid/yaspgrid.hh>
+#if HAVE_UG
+#include <dune/grid/uggrid.hh>
+#endif
+#include <dune/grid/common/communicationpattern.hh>
+#include <dune/grid/common/datahandleif.hh>
+#include <dune/grid/utility/structuredgridfactory.hh>
+
+using namespace Dune;
+
+// adds the received values to the data of an entity
+template<class Mapper>
+class AddDataHandle
+  : public CommDataHandleIF<AddDataHandle<Mapper>, int>
+{
+public:
+  AddDataHandle (const Mapper& mapper, std::vector<int>& data, int codim)
+    : mapper_(mapper), data_(data), codim_(codim)
+  {}
+
+  bool contains (int, int codim) const { return codim == codim_; }
+  bool fixedSize (int, int) const { return true; }
+
+  template<class Entity>
+  std::size_t size (const Entity&) const { return 1; }
+
+  template<class Buffer, class Entity>
+  void gather (Buffer& buffer, const Entity& entity) const
+  {
+    buffer.write(data_[mapper_.index(entity)]);
+  }
+
+  template<class Buffer, class Entity>
+  void scatter (Buffer& buffer, const Entity& entity, std::size_t)
+  {
+    int x;
+    buffer.read(x);
+    data_[mapper_.index(entity)] += x;
+  }
+
+private:
+  const Mapper& mapper_;
+  std::vector<int>& data_;
+  int codim_;
+};
+
+// compares the exchange of the pattern with GridView::communicate
+template<class GridView>
+void checkPattern (TestSuite& t, const CommunicationPattern<GridView>& pattern)
+{
+  const GridView& gv = pattern.gridView();
+  const int rank = gv.comm().rank();
+
+  for (int codim : {0, GridView::dimension})
+    for (InterfaceType iftype : {InteriorBorder_All_Interface, All_All_Interface})
+      for (CommunicationDirection dir : {ForwardCommunication, BackwardCommunication})
+      {
+        const auto& mapper = pattern.mapper(codim);
+        t.check(mapper.size() == std::size_t(gv.size(codim))) << "wrong mapper size for codim " << codim;
+
+        std::vector<int> expected(mapper.size());
+        for (std::size_t i = 0; i < expected.size(); ++i)
+          expected[i] = 1000*rank + i;
+        std::vector<int> actual(expected);
+
+        AddDataHandle<typename CommunicationPattern<GridView>::Mapper> handle(mapper, expected, codim);
+        gv.communicate(handle, iftype, dir);
+        pattern.exchange(actual, iftype, dir, codim, std::plus<int>());
+
+        t.check(actual == expected)
+          << "exchange differs from communicate for codim " << codim << ", interface " << iftype
+          << ", direction " << dir << " on rank " << rank;
+      }
+
+  // overwriting the received values is consistent on all processes
+  const int dim = GridView::dimension;
+  const auto& mapper = pattern.mapper(dim);
+  std::vector<int> owner(mapper.size(), rank);
+  pattern.exchange(owner, InteriorBorder_All_Interface, ForwardCommunication, dim);
+  for (const auto& vertex : vertices(gv, Partitions::interiorBorder))
+    t.check(owner[mapper.index(vertex)] == rank || vertex.partitionType() == BorderEntity)
+      << "interior vertex was overwritten";
+}
+
+int main (int argc, char** argv)
+{
+  MPIHelper::instance(argc, argv);
+
+  TestSuite t;
+
+  // a periodic grid communicates even on a single process
+  YaspGrid<2> periodic({1.0, 1.0}, {{8, 8}}, std::bitset<2>(3ULL), 1);
+  CommunicationPattern<YaspGrid<2>::LeafGridView> periodicPattern(periodic.leafGridView());
+  checkPattern(t, periodicPattern);
+
+  YaspGrid<3> grid({1.0, 1.0, 1.0}, {{4, 4, 4}}, std::bitset<3>(0ULL), 1);
+  CommunicationPattern<YaspGrid<3>::LeafGridView> pattern(grid.leafGridView());
+  checkPattern(t, pattern);
+
+  // the lists are computed anew after a modification of the grid
+  grid.globalRefine(1);
+  pattern.update();
+  checkPattern(t, pattern);
+
+#if HAVE_UG
+  {
+    // an unstructured grid, distributed by its own load balancing
+    typedef UGGrid<2> Grid;
+    FieldVector<double, 2> lower(0.0), upper(1.0);
+    auto ugGrid = StructuredGridFactory<Grid>::createSimplexGrid(lower, upper, {{8, 8}});
+    ugGrid->loadBalance();
+    CommunicationPattern<Grid::LeafGridView> ugPattern(ugGrid->leafGridView());
+    checkPattern(t, ugPattern);
+
+    ugGrid->globalRefine(1);
+    ugPattern.update();
+    checkPattern(t, ugPattern);
+  }
+#endif // #if HAVE_UG
+
+  return t.exit();
+}
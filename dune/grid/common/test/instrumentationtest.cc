@@ -0,0 +1,101 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+/** \file
+    \brief A unit test for the instrumentation of communicate and VTKWriter::write
+ */
+
+#include <config.h>
+
+#define DUNE_GRID_INSTRUMENTATION 1
+
+#include <bitset>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/test/testsuite.hh>
+
+#include <dune/grid/yaspgrid.hh>
+#include <dune/grid/common/datahandleif.hh>
+#include <dune/grid/common/instrumentation.hh>
+#include <dune/grid/io/file/vtk/vtkwriter.hh>
+
+using namespace Dune;
+
+// sends one int per vertex
+class VertexDataHandle
+  : public CommDataHandleIF<VertexDataHandle, int>
+{
+public:
+  bool contains (int dim, int codim) const { return codim == dim; }
+  bool fixedSize (int, int) const { return true; }
+
+  template<class Entity>
+  std::size_t size (const Entity&) const { return 1; }
+
+  template<class Buffer, class Entity>
+  void gather (Buffer& buffer, const Entity&) const { buffer.write(1); }
+
+  template<class Buffer, class Entity>
+  void scatter (Buffer& buffer, const Entity&, std::size_t) { int x; buffer.read(x); }
+};
+
+std::vector<std::string> markers;
+
+void beginMarker (const char* operation) { markers.push_back(std::string("begin ") + operation); }
+void endMarker (const char* operation) { markers.push_back(std::string("end ") + operation); }
+
+int main (int argc, char** argv)
+{
+  MPIHelper::instance(argc, argv);
+
+  TestSuite t;
+  auto& registry = Instrumentation::registry();
+
+  // a periodic grid communicates even on a single process
+  YaspGrid<2> grid({1.0, 1.0}, {{4, 4}}, std::bitset<2>(3ULL), 1);
+  const auto gv = grid.leafGridView();
+
+  VertexDataHandle dataHandle;
+  gv.communicate(dataHandle, All_All_Interface, ForwardCommunication);
+  gv.communicate(dataHandle, All_All_Interface, ForwardCommunication);
+  gv.communicate(dataHandle, InteriorBorder_All_Interface, ForwardCommunication);
+
+  const auto allAll = registry.counters("YaspGrid::communicate", 2, All_All_Interface);
+  t.check(allAll.calls == 2) << "wrong number of calls: " << allAll.calls;
+  t.check(allAll.bytes > 0 && allAll.bytes % (2*sizeof(int)) == 0) << "wrong number of bytes: " << allAll.bytes;
+  t.check(allAll.seconds >= 0.0) << "negative time";
+
+  t.check(registry.counters("YaspGrid::communicate", 2, InteriorBorder_All_Interface).calls == 1)
+    << "interfaces are not recorded separately";
+  t.check(registry.counters("YaspGrid::communicate", 0, All_All_Interface).calls == 0)
+    << "codimensions without data must not be recorded";
+
+  // regions are reported to the marker callbacks
+  registry.setMarkers(&beginMarker, &endMarker);
+  {
+    VTKWriter<YaspGrid<2>::LeafGridView> vtkWriter(gv);
+    vtkWriter.write("instrumentationtest");
+  }
+  registry.setMarkers(nullptr, nullptr);
+
+  const auto vtk = registry.counters("VTKWriter::write");
+  t.check(vtk.calls == 1) << "VTKWriter::write not recorded";
+  t.check(vtk.bytes > 0) << "VTKWriter::write did not count the bytes written";
+  t.check(markers == std::vector<std::string>{"begin VTKWriter::write", "end VTKWriter::write"})
+    << "wrong region markers";
+
+  std::ostringstream json;
+  registry.write(json);
+  t.check(json.str().find("\"operation\": \"YaspGrid::communicate\", \"codim\": 2") != std::string::npos)
+    << "communicate is missing in the JSON output";
+  t.check(json.str().find("\"operation\": \"VTKWriter::write\", \"codim\": null, \"interface\": null") != std::string::npos)
+    << "VTKWriter::write is missing in the JSON output";
+
+  registry.reset();
+  t.check(registry.records().empty()) << "reset did not remove the records";
+
+  return t.exit();
+}
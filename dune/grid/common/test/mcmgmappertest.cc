@@ -13,6 +13,7 @@
 #include <dune/common/parallel/mpihelper.hh>
 #include <dune/grid/common/mcmgmapper.hh>
 #include <dune/grid/uggrid.hh>
+#include <dune/grid/yaspgrid.hh>
 #include "../../../../doc/grids/gridfactory/hybridtestgrids.hh"
 
 using namespace Dune;
@@ -82,9 +83,14 @@ void checkVertexDataMapper(const Mapper& mapper, const GridView& gridView)
   for (const auto& element : elements(gridView))
   {
     size_t numVertices = element.subEntities(dim);
+    const auto vertexIndices = mapper.subIndices(element, dim);
+    if (vertexIndices.size() != numVertices)
+      DUNE_THROW(GridError, "Mapper returns the wrong number of vertex indices!");
     for (size_t curVertex = 0; curVertex < numVertices; ++curVertex)
     {
       size_t index = mapper.subIndex(element, curVertex, dim);
+      if (vertexIndices[curVertex] != index)
+        DUNE_THROW(GridError, "Mapper vertex indices differ from subIndex!");
       min = std::min(min, index);
       max = std::max(max, index);
       indices.insert(index);
@@ -148,11 +154,16 @@ void checkMixedDataMapper(const Mapper& mapper, const GridView& gridView)
 
     // handle edges
     size_t numEdges = element.subEntities(dim-1);
+    const auto edgeIndices = mapper.subIndices(element, dim-1);
+    if (edgeIndices.size() != numEdges)
+      DUNE_THROW(GridError, "Mapper returns the wrong number of edge indices!");
     for (size_t curEdge = 0; curEdge < numEdges; ++curEdge)
     {
       auto block = mapper.indices(element,curEdge,dim-1);
       if (block.empty())
         DUNE_THROW(GridError, "Mapper mixed index does not have edges indices");
+      if (edgeIndices[curEdge] != *block.begin())
+        DUNE_THROW(GridError, "Mapper edge indices differ from subIndex!");
       if (edgeBlockSize == 0) edgeBlockSize = block.size();
       else if (edgeBlockSize != block.size())
         DUNE_THROW(GridError, "Mapper mixed index does not have the same block size on all edges");
@@ -351,6 +362,25 @@ try
     checkGrid(*grid);
   }
 
+  // Do the test for grids with a single element type, which use the fast path of the mapper
+  {
+    typedef YaspGrid<2> Grid;
+    Grid grid({1.0, 1.0}, {{3, 2}});
+    grid.globalRefine(2);
+
+    static_assert(MultipleCodimMultipleGeomTypeMapper<Grid::LeafGridView>::singleGeometryType,
+                  "YaspGrid has a single geometry type");
+    checkGrid(grid);
+  }
+
+  {
+    typedef YaspGrid<3> Grid;
+    Grid grid({1.0, 1.0, 1.0}, {{2, 2, 1}});
+    grid.globalRefine(2);
+
+    checkGrid(grid);
+  }
+
   return EXIT_SUCCESS;
 
 }
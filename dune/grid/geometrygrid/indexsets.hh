@@ -3,6 +3,7 @@
 #ifndef DUNE_GEOGRID_INDEXSETS_HH
 #define DUNE_GEOGRID_INDEXSETS_HH
 
+#include <type_traits>
 #include <vector>
 
 #include <dune/common/typetraits.hh>
@@ -67,6 +68,13 @@ namespace Dune
         return entity.impl().subIndex( hostIndexSet(), i, codim );
       }
 
+      template< int cc >
+      std::enable_if_t< cc == 0, typename Base::SubIndices >
+      subIndices ( const typename Traits::template Codim< cc >::Entity &entity, unsigned int codim ) const
+      {
+        return hostIndexSet().subIndices( entity.impl().hostEntity(), codim );
+      }
+
       IndexType size ( GeometryType type ) const
       {
         return hostIndexSet().size( type );
@@ -3,7 +3,10 @@
 
 #include "config.h"
 
+#include <fstream>
+#include <iomanip>
 #include <memory>
+#include <sstream>
 #include <vector>
 #include <unistd.h>
 
@@ -62,6 +65,14 @@ public:
   }
 };
 
+std::string fileContents(const std::string& name)
+{
+  std::ifstream file(name, std::ios::binary);
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
 template< class GridView >
 void doWrite( const GridView &gridView, Dune::VTK::DataMode dm )
 {
@@ -77,16 +88,38 @@ void doWrite( const GridView &gridView, Dune::VTK::DataMode dm )
   auto vtkWriter = std::make_shared<Dune::VTKWriter<GridView> >(gridView, dm);
   Dune :: VTKSequenceWriter< GridView > vtk( vtkWriter, name.str(), ".", "" );
 
+  // the same sequence written in a background thread
+  auto asyncVtkWriter = std::make_shared<Dune::VTKWriter<GridView> >(gridView, dm);
+  Dune :: VTKSequenceWriter< GridView > asyncVtk( asyncVtkWriter, name.str() + "-async", ".", "" );
+  asyncVtk.setAsynchronous();
+
   vtk.addVertexData(vertexdata,"vertexData");
   vtk.addCellData(celldata,"cellData");
+  asyncVtk.addVertexData(vertexdata,"vertexData");
+  asyncVtk.addCellData(celldata,"cellData");
   auto vectordata = std::make_shared<VTKVectorFunction<GridView> >();
   vtk.addVertexData(vectordata);
+  asyncVtk.addVertexData(vectordata);
   double time = 0;
+  int steps = 0;
   while (time<1) {
     vectordata->setTime(time);
     vtk.write(time);
+    asyncVtk.write(time, steps % 2 ? Dune::VTK::appendedraw : Dune::VTK::ascii);
     time += 0.1;
+    ++steps;
   }
+  asyncVtk.wait();
+
+  // the ascii time steps must not differ from the synchronous ones
+  if (gridView.comm().size() == 1)
+    for (int i = 0; i < steps; i += 2)
+    {
+      std::ostringstream number;
+      number << "-" << std::setw(5) << std::setfill('0') << i << (dim > 1 ? ".vtu" : ".vtp");
+      if (fileContents(name.str() + number.str()) != fileContents(name.str() + "-async" + number.str()))
+        DUNE_THROW(Dune::Exception, "Asynchronous output of " << name.str() << number.str() << " differs");
+    }
 }
 
 template<int dim>
@@ -157,9 +157,9 @@ namespace Dune
         typedef typename PrintType<T>::Type PT;
         if(counter%numPerLine==0) s << indent;
         else s << " ";
-        const auto original_precision = std::cout.precision();
+        const auto original_precision = s.precision();
         s << std::setprecision(std::numeric_limits<PT>::digits10) << (PT) data;
-        std::cout.precision(original_precision);
+        s.precision(original_precision);
         counter++;
         if (counter%numPerLine==0) s << "\n";
       }
@@ -4,12 +4,18 @@
 #ifndef DUNE_GRID_IO_FILE_VTK_VTKSEQUENCEWRITERBASE_HH
 #define DUNE_GRID_IO_FILE_VTK_VTKSEQUENCEWRITERBASE_HH
 
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
 #include <vector>
 #include <iostream>
 #include <sstream>
 #include <fstream>
 #include <iomanip>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 #include <dune/grid/io/file/vtk/common.hh>
 #include <dune/common/path.hh>
@@ -23,6 +29,9 @@ namespace Dune {
    * Derive from this class to write pvd-file suitable for easy visualization with
    * <a href="http://www.vtk.org/">The Visualization Toolkit (VTK)</a>.
    *
+   * The time steps can be written in a background thread, see
+   * setAsynchronous().
+   *
    * \tparam GridView Grid view of the grid we are writing
    *
    */
@@ -35,6 +44,31 @@ namespace Dune {
     std::string name_,path_,extendpath_;
     int rank_;
     int size_;
+
+    // a time step to be written by the background thread
+    struct Job
+    {
+      VTK::VTUSnapshot piece;
+      VTK::OutputType type;
+      std::string pieceName;
+      // the parallel header and the pvd file, empty if not written by this process
+      std::string headerName;
+      std::string header;
+      std::string pvd;
+    };
+
+    // the maximal number of pending time steps, 0 if writing synchronously
+    std::size_t maxPending_ = 0;
+    // the pending time steps, the front one is being written
+    std::deque<std::unique_ptr<Job> > pending_;
+    // written time steps, their snapshots are reused
+    std::vector<std::unique_ptr<Job> > free_;
+    std::exception_ptr error_;
+    bool stop_ = false;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::thread thread_;
+
   public:
     /** \brief Set up the VTKSequenceWriterBase class
      *
@@ -55,6 +89,64 @@ namespace Dune {
         size_(size)
     {}
 
+    //! Write the remaining time steps and stop the background thread
+    ~VTKSequenceWriterBase ()
+    {
+      stopThread();
+      if (error_)
+        std::cerr << "VTKSequenceWriterBase: writing a time step in the background failed" << std::endl;
+    }
+
+    /** \brief Write the time steps in a background thread
+     *
+     * write() then only records the data and the grid of this process in a
+     * snapshot and returns; a background thread encodes the data and writes
+     * the .vtu/.vtp, .pvtu/.pvtp and .pvd files.  The data functions are
+     * evaluated in write(), so the data may be changed as soon as write()
+     * returns.  If maxPending time steps are not written yet, write() waits
+     * until the oldest one is finished.  The snapshots of written time steps
+     * are reused, so with maxPending=2 the simulation fills one buffer while
+     * the other one is written.
+     *
+     * \param maxPending The maximal number of time steps not written yet;
+     *                   0 waits for all of them and writes synchronously again
+     */
+    void setAsynchronous (std::size_t maxPending = 2)
+    {
+      if (maxPending == 0)
+      {
+        stopThread();
+        rethrowError();
+        return;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        maxPending_ = maxPending;
+      }
+      changed_.notify_all();
+      if (!thread_.joinable())
+        thread_ = std::thread([this] () { run(); });
+    }
+
+    //! Whether the time steps are written in a background thread
+    bool asynchronous () const
+    {
+      return maxPending_ > 0;
+    }
+
+    /** \brief Wait until all time steps have been written
+     *
+     * \throw An exception thrown while writing a time step in the background
+     */
+    void wait ()
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      changed_.wait(lock, [this] () { return pending_.empty(); });
+      lock.unlock();
+      rethrowError();
+    }
+
     /**
      * accessor for the underlying VTKWriter instance
      */
@@ -109,6 +201,12 @@ namespace Dune {
       unsigned int count = timesteps_.size();
       timesteps_.push_back(time);
 
+      if (asynchronous())
+      {
+        writeAsynchronous(count, type);
+        return;
+      }
+
       /* write VTK file */
       if(size_==1)
         vtkWriter_->write(concatPaths(path_,seqName(count)),type);
@@ -122,33 +220,173 @@ namespace Dune {
                            std::ios_base::eofbit);
         std::string pvdname = name_ + ".pvd";
         pvdFile.open(pvdname.c_str());
-        pvdFile << "<?xml version=\"1.0\"?> \n"
-                << "<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\"" << VTK::getEndiannessString() << "\"> \n"
-                << "<Collection> \n";
-        for (unsigned int i=0; i<=count; i++)
-        {
-          // filename
-          std::string piecepath;
-          std::string fullname;
-          if(size_==1) {
-            piecepath = path_;
-            fullname = vtkWriter_->getSerialPieceName(seqName(i), piecepath);
-          }
-          else {
-            piecepath = concatPaths(path_, extendpath_);
-            fullname = vtkWriter_->getParallelHeaderName(seqName(i), piecepath, size_);
-          }
-          pvdFile << "<DataSet timestep=\"" << timesteps_[i]
-                  << "\" group=\"\" part=\"0\" name=\"\" file=\""
-                  << fullname << "\"/> \n";
-        }
-        pvdFile << "</Collection> \n"
-                << "</VTKFile> \n" << std::flush;
+        writePvd(pvdFile, count);
         pvdFile.close();
       }
     }
   private:
 
+    // write the pvd file listing the time steps up to count
+    void writePvd (std::ostream& pvdFile, unsigned int count) const
+    {
+      pvdFile << "<?xml version=\"1.0\"?> \n"
+              << "<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\"" << VTK::getEndiannessString() << "\"> \n"
+              << "<Collection> \n";
+      for (unsigned int i=0; i<=count; i++)
+      {
+        // filename
+        std::string piecepath;
+        std::string fullname;
+        if(size_==1) {
+          piecepath = path_;
+          fullname = vtkWriter_->getSerialPieceName(seqName(i), piecepath);
+        }
+        else {
+          piecepath = concatPaths(path_, extendpath_);
+          fullname = vtkWriter_->getParallelHeaderName(seqName(i), piecepath, size_);
+        }
+        pvdFile << "<DataSet timestep=\"" << timesteps_[i]
+                << "\" group=\"\" part=\"0\" name=\"\" file=\""
+                << fullname << "\"/> \n";
+      }
+      pvdFile << "</Collection> \n"
+              << "</VTKFile> \n" << std::flush;
+    }
+
+    // record a time step and hand it to the background thread
+    void writeAsynchronous (unsigned int count, VTK::OutputType type)
+    {
+      std::unique_ptr<Job> job;
+      {
+        // wait for a free slot
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed_.wait(lock, [this] () { return pending_.size() < maxPending_; });
+        if (!free_.empty())
+        {
+          job = std::move(free_.back());
+          free_.pop_back();
+        }
+      }
+      rethrowError();
+      if (!job)
+        job.reset(new Job);
+
+      vtkWriter_->writeSnapshot(job->piece);
+      job->type = type;
+      job->headerName.clear();
+      job->header.clear();
+      job->pvd.clear();
+      if (size_ == 1)
+        job->pieceName = vtkWriter_->getSerialPieceName(seqName(count), path_);
+      else
+      {
+        std::string piecepath = concatPaths(path_, extendpath_);
+        job->pieceName = vtkWriter_->getParallelPieceName(seqName(count), piecepath, rank_, size_);
+        if (rank_ == 0)
+        {
+          std::ostringstream header;
+          vtkWriter_->writeParallelHeader(header, seqName(count), relativePath(path_, piecepath), size_);
+          job->headerName = vtkWriter_->getParallelHeaderName(seqName(count), path_, size_);
+          job->header = header.str();
+        }
+      }
+      if (rank_ == 0)
+      {
+        std::ostringstream pvd;
+        writePvd(pvd, count);
+        job->pvd = pvd.str();
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.push_back(std::move(job));
+      }
+      changed_.notify_all();
+    }
+
+    // the background thread, writes the pending time steps in order
+    void run ()
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (true)
+      {
+        changed_.wait(lock, [this] () { return stop_ || !pending_.empty(); });
+        if (pending_.empty())
+          return;
+
+        Job& job = *pending_.front();
+        lock.unlock();
+        std::exception_ptr error;
+        try {
+          writeJob(job);
+        }
+        catch (...) {
+          error = std::current_exception();
+        }
+        lock.lock();
+
+        if (error && !error_)
+          error_ = error;
+        free_.push_back(std::move(pending_.front()));
+        pending_.pop_front();
+        changed_.notify_all();
+      }
+    }
+
+    // write the files of a time step
+    void writeJob (const Job& job) const
+    {
+      std::ofstream file;
+      file.exceptions(std::ios_base::badbit | std::ios_base::failbit |
+                      std::ios_base::eofbit);
+      file.open(job.pieceName.c_str(), std::ios::binary);
+      job.piece.write(file, job.type);
+      file.close();
+
+      if (!job.header.empty())
+      {
+        file.open(job.headerName.c_str());
+        file << job.header;
+        file.close();
+      }
+
+      if (!job.pvd.empty())
+      {
+        std::string pvdname = name_ + ".pvd";
+        file.open(pvdname.c_str());
+        file << job.pvd << std::flush;
+        file.close();
+      }
+    }
+
+    // write the pending time steps and join the background thread
+    void stopThread ()
+    {
+      if (!thread_.joinable())
+        return;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+      }
+      changed_.notify_all();
+      thread_.join();
+      stop_ = false;
+      maxPending_ = 0;
+      free_.clear();
+    }
+
+    // rethrow an exception of the background thread in the calling thread
+    void rethrowError ()
+    {
+      std::exception_ptr error;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::swap(error, error_);
+      }
+      if (error)
+        std::rethrow_exception(error);
+    }
+
     // create sequence name
     std::string seqName(unsigned int count) const
     {
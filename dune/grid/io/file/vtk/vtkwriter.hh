@@ -25,6 +25,7 @@
 #include <dune/geometry/referenceelements.hh>
 #include <dune/grid/common/mcmgmapper.hh>
 #include <dune/grid/common/gridenums.hh>
+#include <dune/grid/common/instrumentation.hh>
 #include <dune/grid/io/file/vtk/common.hh>
 #include <dune/grid/io/file/vtk/dataarraywriter.hh>
 #include <dune/grid/io/file/vtk/function.hh>
@@ -372,6 +373,8 @@ namespace Dune
       int cornerIndexDune;
       const VertexMapper & vertexmapper;
       std::vector<bool> visited;
+      // in conforming mode, the vertex ids of the corners of the current element
+      typename VertexMapper::SubEntityIndices cornerIds;
       // in conforming mode, for each vertex id (as obtained by vertexmapper)
       // hold its number in the iteration order (VertexIterator)
       int offset;
@@ -393,6 +396,8 @@ namespace Dune
           ++git;
           while( (git != gend) && skipEntity( git->partitionType() ) )
             ++git;
+          if( datamode == VTK::conforming && git != gend )
+            cornerIds = vertexmapper.subIndices(*git,n);
         }
       }
     public:
@@ -405,19 +410,22 @@ namespace Dune
         offset(0)
       {
         if (datamode == VTK::conforming && git != gend)
-          visited[vertexmapper.subIndex(*git,cornerIndexDune,n)] = true;
+        {
+          cornerIds = vertexmapper.subIndices(*git,n);
+          visited[cornerIds[cornerIndexDune]] = true;
+        }
       }
       void increment ()
       {
         switch (datamode)
         {
         case VTK::conforming :
-          while(visited[vertexmapper.subIndex(*git,cornerIndexDune,n)])
+          while(visited[cornerIds[cornerIndexDune]])
           {
             basicIncrement();
             if (git == gend) return;
           }
-          visited[vertexmapper.subIndex(*git,cornerIndexDune,n)] = true;
+          visited[cornerIds[cornerIndexDune]] = true;
           break;
         case VTK::nonconforming :
           basicIncrement();
@@ -486,6 +494,9 @@ namespace Dune
       // NOTE: this is in VTK-numbering, in contrast to VertexIterator.
       int cornerIndexVTK;
       const VertexMapper & vertexmapper;
+      // in conforming mode, the vertex ids of the corners of the current
+      // element, in Dune-numbering
+      typename VertexMapper::SubEntityIndices cornerIds;
       // in conforming mode, for each vertex id (as obtained by vertexmapper)
       // hold its number in the iteration order of VertexIterator (*not*
       // CornerIterator)
@@ -504,7 +515,11 @@ namespace Dune
                      const std::vector<int> & num) :
         git(x), gend(end), datamode(dm), cornerIndexVTK(0),
         vertexmapper(vm),
-        number(num), offset(0) {}
+        number(num), offset(0)
+      {
+        if (datamode == VTK::conforming && git != gend)
+          cornerIds = vertexmapper.subIndices(*git,n);
+      }
       void increment ()
       {
         if( git == gend )
@@ -519,6 +534,8 @@ namespace Dune
           ++git;
           while( (git != gend) && skipEntity( git->partitionType() ) )
             ++git;
+          if( datamode == VTK::conforming && git != gend )
+            cornerIds = vertexmapper.subIndices(*git,n);
         }
       }
       bool equals (const CornerIterator & cit) const
@@ -541,9 +558,7 @@ namespace Dune
         switch (datamode)
         {
         case VTK::conforming :
-          return
-            number[vertexmapper.subIndex(*git,VTK::renumber(*git,cornerIndexVTK),
-                                    n)];
+          return number[cornerIds[VTK::renumber(*git,cornerIndexVTK)]];
         case VTK::nonconforming :
           return offset + VTK::renumber(*git,cornerIndexVTK);
         default :
@@ -857,6 +872,8 @@ namespace Dune
       if(commSize > 1)
         return pwrite(name, "", "", type, commRank, commSize);
 
+      DUNE_GRID_INSTRUMENT_REGION(region, "VTKWriter::write");
+
       // make data mode visible to private functions
       outputtype = type;
 
@@ -878,6 +895,7 @@ namespace Dune
       if (! file.is_open())
         DUNE_THROW(IOError, "Could not write to piece file " << pieceName);
       writeDataFile( file );
+      DUNE_GRID_INSTRUMENT_BYTES(region, std::size_t(file.tellp()));
       file.close();
 
       return pieceName;
@@ -912,6 +930,8 @@ namespace Dune
                        VTK::OutputType ot, const int commRank,
                        const int commSize )
     {
+      DUNE_GRID_INSTRUMENT_REGION(region, "VTKWriter::write");
+
       // make data mode visible to private functions
       outputtype=ot;
 
@@ -936,6 +956,7 @@ namespace Dune
       if (! file.is_open())
         DUNE_THROW(IOError, "Could not write to piecefile file " << fullname);
       writeDataFile(file);
+      DUNE_GRID_INSTRUMENT_BYTES(region, std::size_t(file.tellp()));
       file.close();
       gridView_.comm().barrier();
 
@@ -1040,7 +1061,22 @@ namespace Dune
         (n == 1) ? VTK::polyData : VTK::unstructuredGrid;
 
       VTK::VTUWriter writer(s, outputtype, fileType);
+      writeDataFile(writer);
+    }
 
+    //! record the data file, it can be written later without the grid
+    void writeSnapshot (VTK::VTUSnapshot& snapshot)
+    {
+      VTK::FileType fileType =
+        (n == 1) ? VTK::polyData : VTK::unstructuredGrid;
+
+      VTK::VTUWriter writer(snapshot, fileType);
+      writeDataFile(writer);
+    }
+
+    //! write data file with a VTUWriter
+    void writeDataFile (VTK::VTUWriter& writer)
+    {
       // Grid characteristics
       vertexmapper = new VertexMapper( gridView_, mcmgVertexLayout() );
       if (datamode == VTK::conforming)
@@ -1109,20 +1145,20 @@ namespace Dune
         ncells++;
         // because of the use of vertexmapper->map(), this iteration must be
         // in the order of Dune's numbering.
-        const int subEntities = it->subEntities(n);
-        for (int i=0; i<subEntities; ++i)
+        if (datamode == VTK::conforming)
         {
-          ncorners++;
-          if (datamode == VTK::conforming)
+          for (const auto alpha : vertexmapper->subIndices(*it,n))
           {
-            int alpha = vertexmapper->subIndex(*it,i,n);
+            ncorners++;
             if (number[alpha]<0)
               number[alpha] = nvertices++;
           }
-          else
-          {
-            nvertices++;
-          }
+        }
+        else
+        {
+          const int subEntities = it->subEntities(n);
+          ncorners += subEntities;
+          nvertices += subEntities;
         }
       }
     }
@@ -1411,12 +1447,10 @@ namespace Dune
       std::map< T, T > vxMap;
 
       // get number of local faces
-      const int nVertices = element.subEntities( dim );
+      const auto vxIndices = indexSet.subIndices( element, dim );
+      const int nVertices = vxIndices.size();
       for( int vx = 0; vx < nVertices; ++ vx )
-      {
-        const int vxIdx = indexSet.subIndex( element, vx, dim );
-        vxMap[ vxIdx ] = vertices[ vx ];
-      }
+        vxMap[ vxIndices[ vx ] ] = vertices[ vx ];
 
       // get number of local faces
       const int nFaces = element.subEntities( 1 );
@@ -4,8 +4,14 @@
 #ifndef DUNE_GRID_IO_FILE_VTK_VTUWRITER_HH
 #define DUNE_GRID_IO_FILE_VTK_VTUWRITER_HH
 
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
 #include <ostream>
 #include <string>
+#include <vector>
 
 #include <dune/common/exceptions.hh>
 #include <dune/common/indent.hh>
@@ -20,6 +26,139 @@ namespace Dune {
 
   namespace VTK {
 
+    class VTUWriter;
+
+    //! The contents of a .vtu/.vtp file, recorded to be written later
+    /**
+     * A VTUWriter constructed from a VTUSnapshot does not write anything, it
+     * stores the sections and the values of all data arrays in the snapshot.
+     * write() then produces the file in any OutputType without access to the
+     * grid or to the functions the values came from, e.g., in another thread.
+     * The values of each array are stored as raw bytes in the precision of
+     * the array, so a snapshot takes no more memory than the binary data.
+     */
+    class VTUSnapshot {
+      friend class VTUWriter;
+
+      enum SectionType { pointData, cellData, points, cells };
+
+      struct Array {
+        std::string name;
+        unsigned ncomps;
+        unsigned nitems;
+        Precision prec;
+        // the values, each one in typeSize(prec) bytes
+        std::vector<char> data;
+      };
+
+      struct Section {
+        SectionType type;
+        std::string scalars;
+        std::string vectors;
+        std::vector<Array> arrays;
+        std::size_t narrays;
+      };
+
+      //! a writer storing the values of one array
+      class ArrayWriter : public DataArrayWriter
+      {
+      public:
+        explicit ArrayWriter(Array& array)
+          : DataArrayWriter(array.prec), data(array.data)
+        {
+          data.reserve(std::size_t(array.ncomps)*array.nitems*typeSize(array.prec));
+        }
+
+      private:
+        void writeFloat64 (double value) final
+        { append(value); }
+        void writeFloat32 (float value) final
+        { append(value); }
+        void writeInt32 (std::int32_t value) final
+        { append(value); }
+        void writeUInt32 (std::uint32_t value) final
+        { append(value); }
+        void writeUInt8 (std::uint8_t value) final
+        { append(value); }
+
+        template<class T>
+        void append (T value)
+        {
+          const char* bytes = reinterpret_cast<const char*>(&value);
+          data.insert(data.end(), bytes, bytes + sizeof(T));
+        }
+
+        std::vector<char>& data;
+      };
+
+      //! write the stored values of an array, T is the type of its precision
+      template<class T>
+      static void replay(const Array& array, DataArrayWriter& writer) {
+        for(std::size_t i = 0; i < array.data.size(); i += sizeof(T)) {
+          T value;
+          std::memcpy(&value, array.data.data() + i, sizeof(T));
+          writer.write(value);
+        }
+      }
+
+      FileType fileType;
+      unsigned ncells;
+      unsigned npoints;
+      // sections and arrays beyond the recorded ones keep their memory for
+      // the next recording
+      std::vector<Section> sections;
+      std::size_t nsections;
+
+      void beginSection(SectionType type, const std::string& scalars = "",
+                        const std::string& vectors = "") {
+        if(nsections == sections.size())
+          sections.emplace_back();
+        Section& section = sections[nsections++];
+        section.type = type;
+        section.scalars = scalars;
+        section.vectors = vectors;
+        section.narrays = 0;
+      }
+
+      DataArrayWriter* makeArrayWriter(const std::string& name,
+                                       unsigned ncomps, unsigned nitems,
+                                       Precision prec) {
+        assert(nsections > 0);
+        Section& section = sections[nsections-1];
+        if(section.narrays == section.arrays.size())
+          section.arrays.emplace_back();
+        Array& array = section.arrays[section.narrays++];
+        array.name = name;
+        array.ncomps = ncomps;
+        array.nitems = nitems;
+        array.prec = prec;
+        array.data.clear();
+        return new ArrayWriter(array);
+      }
+
+      inline void writeSections(VTUWriter& writer) const;
+
+    public:
+      //! create an empty snapshot
+      VTUSnapshot()
+        : fileType(unstructuredGrid), ncells(0), npoints(0), nsections(0)
+      { }
+
+      //! remove the recorded contents, the memory is kept for the next recording
+      void clear() {
+        nsections = 0;
+        ncells = 0;
+        npoints = 0;
+      }
+
+      //! write the recorded file to a stream
+      /**
+       * \param s          Stream to write to.
+       * \param outputType How to encode data.
+       */
+      inline void write(std::ostream& s, OutputType outputType) const;
+    };
+
     //! Dump a .vtu/.vtp files contents to a stream
     /**
      * This will help generating a .vtu/.vtp file.  Typical use is like this:
@@ -107,6 +246,14 @@ namespace Dune {
 
       bool doAppended;
 
+      VTUSnapshot* snapshot;
+
+      // a stream without buffer for recording writers, it is never written to
+      static std::ostream& nullStream() {
+        static std::ostream s(nullptr);
+        return s;
+      }
+
     public:
       //! create a VTUWriter object
       /**
@@ -119,7 +266,7 @@ namespace Dune {
        */
       inline VTUWriter(std::ostream& stream_, OutputType outputType,
                        FileType fileType_)
-        : stream(stream_), factory(outputType, stream)
+        : stream(stream_), factory(outputType, stream), snapshot(nullptr)
       {
         switch(fileType_) {
         case polyData :
@@ -143,8 +290,27 @@ namespace Dune {
         ++indent;
       }
 
+      //! create a VTUWriter object that records to a snapshot
+      /**
+       * \param snapshot_ Snapshot to record the file to.
+       * \param fileType_ Whether to write PolyData (1D) or UnstructuredGrid
+       *                  (nD) format.
+       *
+       * Nothing is written to a stream.  The sections and the values of the
+       * data arrays are stored in snapshot_ instead, replacing its previous
+       * contents.  No appended section is requested.
+       */
+      inline VTUWriter(VTUSnapshot& snapshot_, FileType fileType_)
+        : stream(nullStream()), factory(ascii, stream), snapshot(&snapshot_)
+      {
+        snapshot->clear();
+        snapshot->fileType = fileType_;
+      }
+
       //! write footer
       inline ~VTUWriter() {
+        if(snapshot)
+          return;
         --indent;
         stream << indent << "</VTKFile>\n"
                << std::flush;
@@ -164,6 +330,10 @@ namespace Dune {
        */
       inline void beginPointData(const std::string& scalars = "",
                                  const std::string& vectors = "") {
+        if(snapshot) {
+          snapshot->beginSection(VTUSnapshot::pointData, scalars, vectors);
+          return;
+        }
         switch(phase) {
         case main :
           stream << indent << "<PointData";
@@ -178,6 +348,8 @@ namespace Dune {
       }
       //! finish PointData section
       inline void endPointData() {
+        if(snapshot)
+          return;
         switch(phase) {
         case main :
           --indent;
@@ -202,6 +374,10 @@ namespace Dune {
        */
       inline void beginCellData(const std::string& scalars = "",
                                 const std::string& vectors = "") {
+        if(snapshot) {
+          snapshot->beginSection(VTUSnapshot::cellData, scalars, vectors);
+          return;
+        }
         switch(phase) {
         case main :
           stream << indent << "<CellData";
@@ -216,6 +392,8 @@ namespace Dune {
       }
       //! finish CellData section
       inline void endCellData() {
+        if(snapshot)
+          return;
         switch(phase) {
         case main :
           --indent;
@@ -234,6 +412,10 @@ namespace Dune {
        * must be the number of points.
        */
       inline void beginPoints() {
+        if(snapshot) {
+          snapshot->beginSection(VTUSnapshot::points);
+          return;
+        }
         switch(phase) {
         case main :
           stream << indent << "<Points>\n";
@@ -245,6 +427,8 @@ namespace Dune {
       }
       //! finish section for the point coordinates
       inline void endPoints() {
+        if(snapshot)
+          return;
         switch(phase) {
         case main :
           --indent;
@@ -270,6 +454,10 @@ namespace Dune {
        * </ul>
        */
       inline void beginCells() {
+        if(snapshot) {
+          snapshot->beginSection(VTUSnapshot::cells);
+          return;
+        }
         switch(phase) {
         case main :
           stream << indent << "<" << cellName << ">\n";
@@ -281,6 +469,8 @@ namespace Dune {
       }
       //! start section for the grid cells/PolyData lines
       inline void endCells() {
+        if(snapshot)
+          return;
         switch(phase) {
         case main :
           --indent;
@@ -306,6 +496,12 @@ namespace Dune {
        * </ul>
        */
       inline void beginMain(unsigned ncells, unsigned npoints) {
+        phase = main;
+        if(snapshot) {
+          snapshot->ncells = ncells;
+          snapshot->npoints = npoints;
+          return;
+        }
         stream << indent << "<" << fileType << ">\n";
         ++indent;
         stream << indent << "<Piece"
@@ -316,6 +512,8 @@ namespace Dune {
       }
       //! finish the main PolyData/UnstructuredGrid section
       inline void endMain() {
+        if(snapshot)
+          return;
         --indent;
         stream << indent << "</Piece>\n";
         --indent;
@@ -378,10 +576,60 @@ namespace Dune {
       DataArrayWriter* makeArrayWriter(const std::string& name,
                                        unsigned ncomps, unsigned nitems,
                                        Precision prec) {
+        if(snapshot)
+          return snapshot->makeArrayWriter(name, ncomps, nitems, prec);
         return factory.make(name, ncomps, nitems, indent, prec);
       }
     };
 
+    inline void VTUSnapshot::write(std::ostream& s, OutputType outputType) const
+    {
+      VTUWriter writer(s, outputType, fileType);
+
+      writer.beginMain(ncells, npoints);
+      writeSections(writer);
+      writer.endMain();
+
+      if(writer.beginAppended())
+        writeSections(writer);
+      writer.endAppended();
+    }
+
+    inline void VTUSnapshot::writeSections(VTUWriter& writer) const
+    {
+      for(std::size_t i = 0; i < nsections; ++i) {
+        const Section& section = sections[i];
+        switch(section.type) {
+        case pointData : writer.beginPointData(section.scalars, section.vectors); break;
+        case cellData :  writer.beginCellData(section.scalars, section.vectors); break;
+        case points :    writer.beginPoints(); break;
+        case cells :     writer.beginCells(); break;
+        }
+
+        for(std::size_t j = 0; j < section.narrays; ++j) {
+          const Array& array = section.arrays[j];
+          std::shared_ptr<DataArrayWriter> p
+            (writer.makeArrayWriter(array.name, array.ncomps, array.nitems, array.prec));
+          if(p->writeIsNoop())
+            continue;
+          switch(array.prec) {
+          case Precision::float32 : replay<float>(array, *p); break;
+          case Precision::float64 : replay<double>(array, *p); break;
+          case Precision::uint32 :  replay<std::uint32_t>(array, *p); break;
+          case Precision::uint8 :   replay<std::uint8_t>(array, *p); break;
+          case Precision::int32 :   replay<std::int32_t>(array, *p); break;
+          }
+        }
+
+        switch(section.type) {
+        case pointData : writer.endPointData(); break;
+        case cellData :  writer.endCellData(); break;
+        case points :    writer.endPoints(); break;
+        case cells :     writer.endCells(); break;
+        }
+      }
+    }
+
   } // namespace VTK
 
   //! \} group VTK
@@ -12,6 +12,7 @@
 #include <dune/grid/common/capabilities.hh>
 #include <dune/grid/common/grid.hh>
 #include <dune/grid/common/gridfactory.hh>
+#include <dune/grid/common/instrumentation.hh>
 
 #include <dune/geometry/axisalignedcubegeometry.hh>
 #include <dune/geometry/type.hh>
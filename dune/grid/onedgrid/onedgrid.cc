@@ -189,6 +189,8 @@ Dune::OneDGrid::getLeftNeighborWithSon(OneDGridList<OneDEntityImp<1> >::iterator
 
 bool Dune::OneDGrid::adapt()
 {
+  DUNE_GRID_INSTRUMENT_REGION(region, "OneDGrid::adapt");
+
   // for the return value:  true if the grid was changed
   bool refinedGrid = false;
 
@@ -57,6 +57,35 @@ insertElement(const GeometryType& type,
   elements_.back()[1] = vertices[1];
 }
 
+void Dune::GridFactory<Dune::OneDGrid>::
+reserve(std::size_t /* numVertices */, std::size_t numElements)
+{
+  elements_.reserve(numElements);
+}
+
+void Dune::GridFactory<Dune::OneDGrid>::
+insertVertices(const GridFactory<OneDGrid >::ctype* coordinates, std::size_t numVertices)
+{
+  // the hint makes inserting vertices in ascending order cost amortized constant time
+  for (std::size_t i=0; i<numVertices; i++)
+    vertexPositions_.emplace_hint(vertexPositions_.end(), FieldVector<ctype,1>(coordinates[i]), vertexIndex_++);
+}
+
+void Dune::GridFactory<Dune::OneDGrid>::
+insertElements(const GeometryType& type, const unsigned int* vertices, std::size_t numElements)
+{
+  if (type.dim() != 1)
+    DUNE_THROW(GridError, "You cannot insert a " << type << " into a OneDGrid!");
+
+  std::size_t first = elements_.size();
+  elements_.resize(first + numElements);
+  for (std::size_t i=0; i<numElements; i++)
+  {
+    elements_[first+i][0] = vertices[2*i];
+    elements_[first+i][1] = vertices[2*i+1];
+  }
+}
+
 void Dune::GridFactory<Dune::OneDGrid>::
 insertBoundarySegment(const std::vector<unsigned int>& vertices)
 {
@@ -68,6 +68,21 @@ namespace Dune {
     virtual void insertElement(const GeometryType& type,
                                const std::vector<unsigned int>& vertices);
 
+    /** \brief Reserve memory for the given numbers of vertices and elements */
+    virtual void reserve(std::size_t numVertices, std::size_t numElements);
+
+    /** \brief Insert several vertices into the coarse grid at once
+     *
+     * Inserting the vertices in ascending order is fastest.
+     */
+    virtual void insertVertices(const ctype* coordinates, std::size_t numVertices);
+
+    // use default implementation from base class for elements of different types
+    using Base::insertElements;
+
+    /** \brief Insert several elements of the same type into the coarse grid at once */
+    virtual void insertElements(const GeometryType& type, const unsigned int* vertices, std::size_t numElements);
+
     /** \brief Insert a boundary segment (== a point).
         This influences the ordering of the boundary segments
      */
@@ -101,6 +101,127 @@ namespace Dune
     checkGridFactory< Grid >( mesh, [] ( const typename Mesh::Vertex &v ) { return v; } );
   }
 
+
+  // checkGridFactoryBulkInsertion
+  // -----------------------------
+
+  // the corners of the elements of a grid created by a factory, by insertion index
+  template< class Grid >
+  std::vector< std::vector< FieldVector< typename Grid::ctype, Grid::dimensionworld > > >
+  elementCornersByInsertionIndex ( const GridFactory< Grid > &factory, const Grid &grid )
+  {
+    std::vector< std::vector< FieldVector< typename Grid::ctype, Grid::dimensionworld > > > corners( grid.leafGridView().size( 0 ) );
+    for( const auto element : elements( grid.leafGridView() ) )
+    {
+      const auto geometry = element.geometry();
+      auto &elementCorners = corners.at( factory.insertionIndex( element ) );
+      for( int i = 0; i < geometry.corners(); ++i )
+        elementCorners.push_back( geometry.corner( i ) );
+    }
+    return corners;
+  }
+
+  // check that two grids created from the same mesh by different factory methods agree
+  template< class Grid >
+  void compareGridFactoryGrids ( const GridFactory< Grid > &factory, const Grid &grid,
+                                 const GridFactory< Grid > &otherFactory, const Grid &otherGrid,
+                                 const char *method )
+  {
+    const auto corners = elementCornersByInsertionIndex( factory, grid );
+    const auto otherCorners = elementCornersByInsertionIndex( otherFactory, otherGrid );
+    if( (corners.size() != otherCorners.size()) || (grid.leafGridView().size( Grid::dimension ) != otherGrid.leafGridView().size( Grid::dimension )) )
+      DUNE_THROW( GridError, "GridFactory error, " << method << " creates a grid of a different size than insertElement!" );
+    for( std::size_t i = 0; i < corners.size(); ++i )
+    {
+      if( corners[ i ].size() != otherCorners[ i ].size() )
+        DUNE_THROW( GridError, "GridFactory error, " << method << " creates an element of a different type than insertElement!" );
+      for( std::size_t j = 0; j < corners[ i ].size(); ++j )
+        if( (corners[ i ][ j ] - otherCorners[ i ][ j ]).two_norm() > 1e-8 )
+          DUNE_THROW( GridError, "GridFactory error, " << method << " creates an element different from insertElement!" );
+    }
+  }
+
+  template< class Grid, class Mesh >
+  void checkGridFactoryBulkInsertion ( const Mesh &mesh )
+  {
+    typedef typename Grid::ctype ctype;
+    const int dimworld = Grid::dimensionworld;
+
+    // flatten the mesh
+    std::vector< ctype > coordinates;
+    for( const auto &v : mesh.vertices )
+      coordinates.insert( coordinates.end(), v.begin(), v.end() );
+
+    std::vector< GeometryType > types;
+    std::vector< unsigned int > corners;
+    std::vector< std::size_t > offsets( 1, 0 );
+    for( const auto &e : mesh.elements )
+    {
+      types.push_back( e.first );
+      corners.insert( corners.end(), e.second.begin(), e.second.end() );
+      offsets.push_back( corners.size() );
+    }
+
+    GridFactory< Grid > factory;
+    factory.reserve( mesh.vertices.size(), mesh.elements.size() );
+    factory.insertVertices( coordinates.data(), mesh.vertices.size() );
+    factory.insertElements( types.data(), corners.data(), offsets.data(), types.size() );
+
+    std::unique_ptr< Grid > gridptr( factory.createGrid() );
+    const auto gridView = gridptr->leafGridView();
+
+    if( (std::size_t)gridView.size( 0 ) != mesh.elements.size() )
+      DUNE_THROW( GridError, "GridFactory error, wrong number of elements after bulk insertion!" );
+
+    for( const auto vertex : vertices( gridView ) )
+    {
+      std::size_t idx = factory.insertionIndex( vertex );
+      FieldVector< ctype, dimworld > v( mesh.vertices[ idx ] );
+      if( (v - vertex.geometry().center()).two_norm() > 1e-8 )
+        DUNE_THROW( GridError, "GridFactory error, Vertex insertion Index wrong after bulk insertion!" );
+    }
+
+    std::vector< unsigned int > indices;
+    for( const auto element : elements( gridView ) )
+    {
+      std::size_t idx = factory.insertionIndex( element );
+      if( element.type() != mesh.elements[ idx ].first )
+        DUNE_THROW( GridError, "GridFactory error, wrong element type after bulk insertion!" );
+
+      indices.clear();
+      for( unsigned int i = 0; i < element.subEntities( Grid::dimension ); ++i )
+        indices.push_back( factory.insertionIndex( element.template subEntity< Grid::dimension >( i ) ) );
+
+      if( !std::is_permutation( indices.begin(), indices.end(), mesh.elements[ idx ].second.begin() ) )
+        DUNE_THROW( GridError, "GridFactory error, Element insertion index wrong after bulk insertion!" );
+    }
+
+    // insert the runs of elements of the same type with the single type method
+    GridFactory< Grid > runFactory;
+    runFactory.reserve( mesh.vertices.size(), mesh.elements.size() );
+    runFactory.insertVertices( coordinates.data(), mesh.vertices.size() );
+    for( std::size_t i = 0; i < types.size(); )
+    {
+      std::size_t j = i+1;
+      while( (j < types.size()) && (types[ j ] == types[ i ]) )
+        ++j;
+      runFactory.insertElements( types[ i ], corners.data() + offsets[ i ], j-i );
+      i = j;
+    }
+    std::unique_ptr< Grid > runGrid( runFactory.createGrid() );
+
+    // insert the vertices and elements one by one
+    GridFactory< Grid > elementFactory;
+    for( const auto &v : mesh.vertices )
+      elementFactory.insertVertex( FieldVector< ctype, dimworld >( v ) );
+    for( const auto &e : mesh.elements )
+      elementFactory.insertElement( e.first, e.second );
+    std::unique_ptr< Grid > elementGrid( elementFactory.createGrid() );
+
+    compareGridFactoryGrids( factory, *gridptr, elementFactory, *elementGrid, "insertElements with offsets" );
+    compareGridFactoryGrids( runFactory, *runGrid, elementFactory, *elementGrid, "insertElements with a single type" );
+  }
+
 } // namespace Dune
 
 #endif // #ifndef DUNE_GRID_TEST_CHECKGRIDFACTORY_HH
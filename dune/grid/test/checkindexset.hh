@@ -12,9 +12,11 @@
 
 #include <dune/common/fvector.hh>
 #include <dune/common/stdstreams.hh>
+#include <dune/common/typeutilities.hh>
 #include <dune/geometry/referenceelements.hh>
 #include <dune/grid/common/capabilities.hh>
 #include <dune/grid/common/exceptions.hh>
+#include <dune/grid/common/indexidset.hh>
 
 /** @file
    @author Robert Kloefkorn
@@ -45,6 +47,39 @@ namespace Dune
     return (vx1-vx2).infinity_norm() < eps;
   }
 
+  // the implementation behind the index set interface
+  template< class IndexSetType >
+  const IndexSetType &indexSetImplementation ( const IndexSetType &indexSet )
+  {
+    return indexSet;
+  }
+
+  template< class GridImp, class IndexSetImp, class IndexTypeImp, class TypesImp >
+  const IndexSetImp &indexSetImplementation ( const IndexSet< GridImp, IndexSetImp, IndexTypeImp, TypesImp > &indexSet )
+  {
+    return static_cast< const IndexSetImp & >( indexSet );
+  }
+
+  // compare the subIndices of the index set implementation, if it provides one, with subIndex
+  template< class IndexSetImp, class IndexSetType, class Element >
+  auto checkNativeSubIndices ( const IndexSetImp &imp, const IndexSetType &lset, const Element &en, int codim, PriorityTag< 1 > )
+    -> decltype( imp.template subIndices< 0 >( en, codim ), void() )
+  {
+    const auto subIndices = imp.template subIndices< 0 >( en, codim );
+    if( subIndices.size() != en.subEntities( codim ) )
+      DUNE_THROW( GridError, "the index set implementation's subIndices returns the wrong number of indices for codim " << codim );
+    for( unsigned int subEntity = 0; subEntity < en.subEntities( codim ); ++subEntity )
+    {
+      if( subIndices[ subEntity ] != lset.subIndex( en, subEntity, codim ) )
+        DUNE_THROW( GridError, "the index set implementation's subIndices( en, " << codim << " )[ " << subEntity
+                               << " ] != subIndex( en, " << subEntity << ", " << codim << " )" );
+    }
+  }
+
+  template< class IndexSetImp, class IndexSetType, class Element >
+  void checkNativeSubIndices ( const IndexSetImp &, const IndexSetType &, const Element &, int, PriorityTag< 0 > )
+  {}
+
   /** \brief Check various features of codim-0 entities (elements)
       \param grid The grid we are testing
       \param en The grid element we are testing
@@ -91,6 +126,18 @@ namespace Dune
                  "wrong number of subEntities of codim " << codim);
     }
 
+    // the indices of all subentities at once must match the single ones
+    const auto subIndices = lset.subIndices( en, codim );
+    if( int( subIndices.size() ) != refElem.size( 0, 0, codim ) )
+      DUNE_THROW( GridError, "subIndices returns the wrong number of indices for codim " << codim );
+    for( int subEntity = 0; subEntity < refElem.size( 0, 0, codim ); ++subEntity )
+    {
+      if( subIndices[ subEntity ] != lset.subIndex( en, subEntity, codim ) )
+        DUNE_THROW( GridError, "subIndices( en, " << codim << " )[ " << subEntity << " ] != subIndex( en, "
+                               << subEntity << ", " << codim << " )" );
+    }
+    checkNativeSubIndices( indexSetImplementation( lset ), lset, en, codim, PriorityTag< 42 >() );
+
     for( int subEntity = 0; subEntity < refElem.size( 0, 0, codim ); ++subEntity )
     {
 
@@ -4,6 +4,7 @@
 
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 #ifndef GRIDDIM
 #define GRIDDIM ALBERTA_DIM
@@ -126,11 +127,13 @@ try {
 #if ALBERTA_DIM == 2 && GRIDDIM == 2
   std::cout << "Check GridFactory ..." <<std::endl;
   Dune::checkGridFactory< GridType >( Dune::TestGrids::kuhn2d );
+  Dune::checkGridFactoryBulkInsertion< GridType >( Dune::TestGrids::kuhn2d );
 #endif // #if ALBERTA_DIM == 2 && GRIDDIM == 2
 
 #if ALBERTA_DIM == 3 && GRIDDIM == 3
   std::cout << "Check GridFactory ..." <<std::endl;
   Dune::checkGridFactory< GridType >( Dune::TestGrids::kuhn3d );
+  Dune::checkGridFactoryBulkInsertion< GridType >( Dune::TestGrids::kuhn3d );
 #endif // #if ALBERTA_DIM == 3 && GRIDDIM == 3
 
   std::string filename;
@@ -207,6 +210,33 @@ try {
       checkIterators( grid.leafGridView() );
     }
 
+    // the leaf index set follows the adaptation incrementally
+    std::cout << ">>> Coarsening all elements and checking again..." << std::endl;
+    for( const auto &element : elements( grid.leafGridView() ) )
+      grid.mark( -1, element );
+    grid.preAdapt();
+    grid.adapt();
+    grid.postAdapt();
+    gridcheck(grid);
+    checkIterators( grid.leafGridView() );
+
+    // iteration over the leaf snapshot visits the same elements in the same order
+    std::cout << ">>> Checking iteration over the leaf snapshot..." << std::endl;
+    {
+      const auto &indexSet = grid.leafIndexSet();
+      std::vector< int > treeOrder, snapshotOrder;
+      for( const auto &element : elements( grid.leafGridView() ) )
+        treeOrder.push_back( indexSet.index( element ) );
+      grid.setLeafSnapshot( true );
+      for( const auto &element : elements( grid.leafGridView() ) )
+        snapshotOrder.push_back( indexSet.index( element ) );
+      if( snapshotOrder != treeOrder )
+        DUNE_THROW( Dune::GridError, "Leaf snapshot differs from tree traversal." );
+    }
+    markOne( grid, 0, dim );
+    gridcheck(grid);
+    checkIterators( grid.leafGridView() );
+
     checkGeometryInFather(grid);
     checkIntersectionIterator(grid,true);
     checkTwists( grid.leafGridView(), NoMapTwist() );
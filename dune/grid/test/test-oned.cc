@@ -7,11 +7,13 @@
 #include <memory>
 
 #include <dune/grid/onedgrid.hh>
+#include <doc/grids/gridfactory/testgrids.hh>
 
 #include "gridcheck.hh"
 #include "checkgeometryinfather.hh"
 #include "checkintersectionit.hh"
 #include "checkadaptation.hh"
+#include "checkgridfactory.hh"
 
 using namespace Dune;
 
@@ -156,6 +158,26 @@ int main () try
 
   testOneDGrid(*factoryGrid);
 
+  // Insert the vertices and elements of a grid in bulk, not in ascending order
+  const Dune::TestGrid<1> bulkGrid = {
+    { { 0.5 }, { -1.0 }, { 2.0 }, { 0.0 } },
+    { { Dune::GeometryTypes::line, { 3, 0 } },
+      { Dune::GeometryTypes::line, { 1, 3 } },
+      { Dune::GeometryTypes::line, { 0, 2 } } },
+    {}
+  };
+  Dune::checkGridFactoryBulkInsertion<Dune::OneDGrid>(bulkGrid);
+
+  // The same in ascending order, where inserting the vertices takes a shortcut
+  const Dune::TestGrid<1> ascendingBulkGrid = {
+    { { -1.0 }, { 0.0 }, { 0.5 }, { 2.0 } },
+    { { Dune::GeometryTypes::line, { 0, 1 } },
+      { Dune::GeometryTypes::line, { 1, 2 } },
+      { Dune::GeometryTypes::line, { 2, 3 } } },
+    {}
+  };
+  Dune::checkGridFactoryBulkInsertion<Dune::OneDGrid>(ascendingBulkGrid);
+
   // Create a OneDGrid with an array of vertex coordinates and test it
   std::vector<double> coords = {-1,
                                 -0.4,
@@ -5,6 +5,7 @@
 #include <config.h>
 
 #include <unistd.h>
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -499,6 +500,31 @@ public:
     std::cout << gv.comm().rank()
               << ": load balancing with data was successful." << std::endl;
   }
+
+  template<int... codimensions>
+  static void testTargetProcessors(Grid& grid)
+  {
+    const Codims codims = toBitset<codimensions...>();
+    const auto& gv = grid.leafGridView();
+
+    Data data;
+    LBDataHandle dataHandle(grid.localIdSet(), data, codims);
+    fillVector<codimensions...>(gv, data);
+
+    // send the elements to the processes in slabs along the x axis
+    const int size = gv.comm().size();
+    Dune::MultipleCodimMultipleGeomTypeMapper<GridView> mapper(gv, Dune::mcmgElementLayout());
+    std::vector<typename Grid::Rank> targetProcessors(gv.size(0), 0);
+    for (const auto& element : elements(gv, Dune::Partitions::interior))
+      targetProcessors[mapper.index(element)] = std::min(int(element.geometry().center()[0] * size), size-1);
+
+    grid.loadBalance(targetProcessors, 0, dataHandle);
+
+    checkVector<codimensions...>(gv, data);
+
+    std::cout << gv.comm().rank()
+              << ": load balancing to given target processors with data was successful." << std::endl;
+  }
 };
 
 template<typename Grid>
@@ -525,6 +551,9 @@ void testLoadBalance(bool simplexGrid, bool localRefinement, int refinementDim,
   auto grid = setupGrid<Grid>(simplexGrid, localRefinement, refinementDim, refineUpperPart);
   LoadBalance<Grid>::template test<codimensions...>(*grid);
   // LoadBalance<Grid>::template test<codimensions...>(*grid);
+
+  grid = setupGrid<Grid>(simplexGrid, localRefinement, refinementDim, refineUpperPart);
+  LoadBalance<Grid>::template testTargetProcessors<codimensions...>(*grid);
 }
 
 template<int dim>
@@ -5,6 +5,7 @@
 
 #include <iostream>
 #include <memory>
+#include <type_traits>
 
 #include <dune/common/parallel/mpihelper.hh>
 
@@ -13,9 +14,11 @@
  */
 #include <dune/grid/uggrid.hh>
 #include <doc/grids/gridfactory/hybridtestgrids.hh>
+#include <doc/grids/gridfactory/testgrids.hh>
 
 #include "gridcheck.hh"
 #include "checkcommunicate.hh"
+#include "checkgridfactory.hh"
 #include "checkgeometryinfather.hh"
 #include "checkintersectionit.hh"
 #include "checkpartition.hh"
@@ -23,6 +26,14 @@
 
 using namespace Dune;
 
+// entity seeds are a single pointer that can be stored in flat arrays
+static_assert(std::is_trivially_copyable<UGGrid<3>::Codim<0>::EntitySeed>::value
+              && sizeof(UGGrid<3>::Codim<0>::EntitySeed) == sizeof(void*),
+              "UGGrid element seeds are not compact");
+static_assert(std::is_trivially_copyable<UGGrid<2>::Codim<2>::EntitySeed>::value
+              && sizeof(UGGrid<2>::Codim<2>::EntitySeed) == sizeof(void*),
+              "UGGrid vertex seeds are not compact");
+
 class ArcOfCircle : public Dune::BoundarySegment<2>
 {
 public:
@@ -249,6 +260,13 @@ int main (int argc , char **argv) try
 #ifdef ModelP
   }
 #endif
+  // ////////////////////////////////////////////////////////////////////////
+  //   Check the bulk insertion methods of the grid factory
+  // ////////////////////////////////////////////////////////////////////////
+  std::cout << "Testing bulk insertion into the GridFactory" << std::endl;
+  Dune::checkGridFactoryBulkInsertion<Dune::UGGrid<2> >(Dune::TestGrids::hybrid2d);
+  Dune::checkGridFactoryBulkInsertion<Dune::UGGrid<3> >(Dune::TestGrids::hybrid3d);
+
   // ////////////////////////////////////////////////////////////////////////
   //   Check whether geometryInFather returns equal results with and
   //   without parametrized boundaries
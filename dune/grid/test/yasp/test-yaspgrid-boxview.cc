@@ -0,0 +1,138 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#include <config.h>
+
+#include <iostream>
+#include <set>
+#include <utility>
+
+#include <dune/common/hybridutilities.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/test/testsuite.hh>
+
+#include <dune/grid/yaspgrid.hh>
+
+using Dune::TestSuite;
+
+// collect all indices covered by the boxes of one codimension and partition
+template<class BoxView>
+std::set<int> boxIndices (const BoxView& bv, int codim, Dune::PartitionIteratorType pitype)
+{
+  const int dim = BoxView::dimension;
+  std::set<int> indices;
+
+  for (int which = 0; which < bv.boxes(codim); ++which)
+  {
+    const auto& box = bv.box(codim, which, pitype);
+    if (box.empty())
+      continue;
+
+    const auto stride = bv.strides(codim, which);
+    const int first = bv.index(codim, which, box.origin());
+
+    // run over the box with a multi-index
+    std::array<int,dim> k;
+    std::fill(k.begin(), k.end(), 0);
+    for (int n = 0; n < box.totalsize(); ++n)
+    {
+      int idx = first;
+      for (int i = 0; i < dim; ++i)
+        idx += k[i]*stride[i];
+      indices.insert(idx);
+
+      for (int i = 0; i < dim; ++i)
+        if (++k[i] < box.size(i))
+          break;
+        else
+          k[i] = 0;
+    }
+  }
+  return indices;
+}
+
+template<Dune::PartitionIteratorType pitype, class GridView>
+TestSuite checkPartition (const GridView& gv)
+{
+  TestSuite t;
+  const int dim = GridView::dimension;
+  const auto bv = Dune::yaspBoxView(gv);
+
+  Dune::Hybrid::forEach(std::make_index_sequence<dim+1>{}, [&](auto codim)
+  {
+    t.check(bv.size(codim) == int(gv.indexSet().size(codim)))
+      << "box view size mismatch for codim " << codim;
+
+    std::set<int> iterated;
+    for (const auto& e : entities(gv, Dune::Codim<codim>{}, Dune::Partitions::All))
+    {
+      const auto& it = e.impl().transformingsubiterator();
+      const int which = bv.which(codim, it.shift());
+
+      // the box view and the index set have to agree on each entity
+      t.check(bv.index(codim, which, it.coord()) == int(gv.indexSet().index(e)))
+        << "box view index mismatch for codim " << codim;
+
+      if (bv.box(codim, which, pitype).inside(it.coord()))
+        iterated.insert(gv.indexSet().index(e));
+    }
+
+    std::set<int> boxed = boxIndices(bv, codim, pitype);
+    t.check(boxed == iterated)
+      << "box view does not cover partition " << pitype << " for codim " << codim;
+  });
+
+  return t;
+}
+
+template<class GridView>
+TestSuite checkBoxView (const GridView& gv)
+{
+  TestSuite t;
+  t.subTest(checkPartition<Dune::Interior_Partition>(gv));
+  t.subTest(checkPartition<Dune::InteriorBorder_Partition>(gv));
+  t.subTest(checkPartition<Dune::Overlap_Partition>(gv));
+  t.subTest(checkPartition<Dune::All_Partition>(gv));
+
+  // YaspGrid has no ghosts
+  const auto bv = Dune::yaspBoxView(gv);
+  for (int codim = 0; codim <= GridView::dimension; ++codim)
+    for (int which = 0; which < bv.boxes(codim); ++which)
+      t.check(bv.box(codim, which, Dune::Ghost_Partition).empty());
+
+  return t;
+}
+
+template<int dim>
+TestSuite checkYaspBoxView ()
+{
+  TestSuite t;
+
+  Dune::FieldVector<double,dim> len(1.0);
+  std::array<int,dim> s;
+  std::fill(s.begin(), s.end(), 6);
+  s[0] = 8;
+  std::bitset<dim> periodic(0);
+  periodic[0] = true;
+
+  Dune::YaspGrid<dim> grid(len, s, periodic, 1);
+  grid.globalRefine(1);
+
+  t.subTest(checkBoxView(grid.leafGridView()));
+  for (int level = 0; level <= grid.maxLevel(); ++level)
+    t.subTest(checkBoxView(grid.levelGridView(level)));
+
+  return t;
+}
+
+int main (int argc, char** argv)
+{
+  Dune::MPIHelper::instance(argc, argv);
+
+  TestSuite t;
+  t.subTest(checkYaspBoxView<1>());
+  t.subTest(checkYaspBoxView<2>());
+  t.subTest(checkYaspBoxView<3>());
+
+  return t.exit();
+}
@@ -0,0 +1,123 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#include <config.h>
+
+#include <cmath>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include <dune/common/hybridutilities.hh>
+#include <dune/common/math.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/test/testsuite.hh>
+
+#include <dune/grid/yaspgrid.hh>
+#include <dune/grid/yaspgrid/yasphaloindexset.hh>
+
+using Dune::TestSuite;
+
+// a function of the position that is periodic on the unit cube
+template<class Coordinate>
+double f (const Coordinate& x)
+{
+  double v = 0.0;
+  for (std::size_t i = 0; i < x.size(); ++i)
+    v += (i+1) * std::cos(2.0*Dune::StandardMathematicalConstants<double>::pi()*x[i]);
+  return v;
+}
+
+template<class GridView>
+TestSuite checkHaloIndexSet (const GridView& gv)
+{
+  TestSuite t;
+  const int dim = GridView::dimension;
+
+  Dune::YaspHaloIndexSet<const typename GridView::Grid> indexSet(gv);
+
+  Dune::Hybrid::forEach(std::make_index_sequence<dim+1>{}, [&](auto codim)
+  {
+    const std::size_t size = indexSet.size(codim);
+    t.check(size == gv.indexSet().size(codim))
+      << "halo index set size mismatch for codim " << codim;
+
+    // the numbering has to be a permutation with interior entities first
+    std::vector<int> count(size, 0);
+    for (const auto& e : entities(gv, Dune::Codim<codim>{}))
+    {
+      const auto idx = indexSet.index(e);
+      t.require(idx < size) << "index out of range";
+      count[idx]++;
+
+      if (e.partitionType() == Dune::InteriorEntity)
+        t.check(idx < indexSet.interiorSize(codim))
+          << "owned interior entity numbered after the border";
+      if (e.partitionType() == Dune::OverlapEntity || e.partitionType() == Dune::FrontEntity)
+        t.check(idx >= indexSet.ownedSize(codim))
+          << "overlap entity numbered as owned";
+    }
+    for (std::size_t i = 0; i < size; ++i)
+      t.check(count[i] == 1) << "index " << i << " assigned " << count[i] << " times";
+
+    // the receive blocks cover exactly the non-owned entities
+    std::size_t next = indexSet.ownedSize(codim);
+    for (const auto& block : indexSet.recvBlocks(codim))
+    {
+      t.check(block.begin == next) << "receive blocks are not contiguous";
+      next = block.end;
+    }
+    t.check(next == size) << "receive blocks do not cover the halo";
+
+    // exchange data set on owned entities only and compare with the expected values
+    std::vector<double> data(size, 0.0);
+    for (const auto& e : entities(gv, Dune::Codim<codim>{}))
+      if (indexSet.owns(e))
+        data[indexSet.index(e)] = f(e.geometry().center());
+
+    indexSet.exchange(data, codim);
+
+    for (const auto& e : entities(gv, Dune::Codim<codim>{}))
+      t.check(std::abs(data[indexSet.index(e)] - f(e.geometry().center())) < 1e-10)
+        << "wrong value after halo exchange on codim " << codim;
+  });
+
+  return t;
+}
+
+template<int dim>
+TestSuite checkYaspHaloIndexSet (bool periodic)
+{
+  TestSuite t;
+
+  Dune::FieldVector<double,dim> len(1.0);
+  std::array<int,dim> s;
+  std::fill(s.begin(), s.end(), 6);
+  s[0] = 8;
+  std::bitset<dim> p(0);
+  p[0] = periodic;
+
+  Dune::YaspGrid<dim> grid(len, s, p, 1);
+  t.subTest(checkHaloIndexSet(grid.leafGridView()));
+
+  grid.globalRefine(1);
+  t.subTest(checkHaloIndexSet(grid.leafGridView()));
+  t.subTest(checkHaloIndexSet(grid.levelGridView(0)));
+
+  return t;
+}
+
+int main (int argc, char** argv)
+{
+  Dune::MPIHelper::instance(argc, argv);
+
+  TestSuite t;
+  for (bool periodic : {false, true})
+  {
+    t.subTest(checkYaspHaloIndexSet<1>(periodic));
+    t.subTest(checkYaspHaloIndexSet<2>(periodic));
+    t.subTest(checkYaspHaloIndexSet<3>(periodic));
+  }
+
+  return t.exit();
+}
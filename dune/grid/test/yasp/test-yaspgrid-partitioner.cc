@@ -0,0 +1,202 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#include <config.h>
+
+#include <iostream>
+#include <set>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/test/testsuite.hh>
+
+#include <dune/grid/yaspgrid.hh>
+
+#include "../gridcheck.hh"
+
+using Dune::TestSuite;
+
+// check the torus layout produced for a given node layout without running in parallel
+template<int dim>
+TestSuite checkNodeLayout (const std::array<int,dim>& size, const std::vector<int>& nodes)
+{
+  TestSuite t;
+  typedef std::array<int,dim> iTupel;
+
+  const int P = nodes.size();
+  Dune::YaspNodeAwarePartitioner<dim> partitioner(nodes);
+
+  iTupel dims;
+  partitioner.loadbalance(size, P, dims);
+  int prod = 1;
+  for (int i=0; i<dim; i++)
+    prod *= dims[i];
+  t.require(prod == P) << "torus dimensions do not match the number of processes";
+
+  std::vector<iTupel> coords;
+  partitioner.rankCoordinates(dims, P, coords);
+  if (partitioner.nodes() == 0)
+  {
+    t.check(coords.empty()) << "uneven node layout should fall back to lexicographic placement";
+    return t;
+  }
+  t.require(int(coords.size()) == P);
+
+  // each position is taken exactly once
+  std::set<iTupel> positions(coords.begin(), coords.end());
+  t.check(int(positions.size()) == P) << "rank coordinates are not a permutation";
+
+  // the ranks of a node form a box of the torus
+  for (int n : std::set<int>(nodes.begin(), nodes.end()))
+  {
+    iTupel lower, upper;
+    std::fill(lower.begin(), lower.end(), P);
+    std::fill(upper.begin(), upper.end(), -1);
+    int count = 0;
+    for (int r=0; r<P; r++)
+      if (nodes[r] == n)
+      {
+        count++;
+        for (int i=0; i<dim; i++)
+        {
+          lower[i] = std::min(lower[i], coords[r][i]);
+          upper[i] = std::max(upper[i], coords[r][i]);
+        }
+      }
+    int volume = 1;
+    for (int i=0; i<dim; i++)
+      volume *= upper[i] - lower[i] + 1;
+    t.check(volume == count) << "ranks of node " << n << " do not form a box";
+  }
+
+  return t;
+}
+
+// check that the weighted partitioner balances a cost concentrated at one end of the domain
+template<int dim>
+TestSuite checkWeighted (const std::array<int,dim>& size, int P)
+{
+  TestSuite t;
+  typedef std::array<int,dim> iTupel;
+
+  auto cost = [](const iTupel& e) { return e[0] < 4 ? 20.0 : 1.0; };
+  Dune::YaspWeightedPartitioner<dim> partitioner(cost);
+
+  iTupel dims;
+  partitioner.loadbalance(size, P, dims);
+  std::array<std::vector<int>,dim> cuts;
+  partitioner.cuts(size, dims, cuts);
+
+  for (int i=0; i<dim; i++)
+  {
+    t.require(int(cuts[i].size()) == dims[i]+1) << "wrong number of cuts in direction " << i;
+    t.check(cuts[i].front() == 0 && cuts[i].back() == size[i]) << "cuts do not cover direction " << i;
+    for (int j=0; j<dims[i]; j++)
+      t.check(cuts[i][j] < cuts[i][j+1]) << "empty piece in direction " << i;
+  }
+
+  // maximum cost of a piece for the given cuts
+  auto maxCost = [&](const std::array<std::vector<int>,dim>& c)
+  {
+    double m = 0.0;
+    iTupel p;
+    std::fill(p.begin(), p.end(), 0);
+    for (int n=0; n<P; n++)
+    {
+      double sum = 0.0;
+      iTupel e;
+      for (int i=0; i<dim; i++)
+        e[i] = c[i][p[i]];
+      while (true)
+      {
+        sum += cost(e);
+        int i = 0;
+        for (; i<dim; i++)
+          if (++e[i] < c[i][p[i]+1])
+            break;
+          else
+            e[i] = c[i][p[i]];
+        if (i == dim)
+          break;
+      }
+      m = std::max(m, sum);
+      for (int i=0; i<dim; i++)
+        if (++p[i] < dims[i])
+          break;
+        else
+          p[i] = 0;
+    }
+    return m;
+  };
+
+  std::array<std::vector<int>,dim> equal;
+  for (int i=0; i<dim; i++)
+    for (int j=0; j<=dims[i]; j++)
+      equal[i].push_back((j*size[i])/dims[i]);
+
+  if (dims[0] > 1)
+    t.check(maxCost(cuts) < maxCost(equal)) << "weighted cuts do not improve the balance";
+  else
+    t.check(maxCost(cuts) <= maxCost(equal)) << "weighted cuts make the balance worse";
+
+  return t;
+}
+
+int main (int argc, char** argv)
+{
+  const auto& mpiHelper = Dune::MPIHelper::instance(argc, argv);
+
+  TestSuite t;
+
+  // two nodes with four ranks each, interleaved and block-wise numbering
+  t.subTest(checkNodeLayout<2>({64, 64}, {0, 0, 0, 0, 1, 1, 1, 1}));
+  t.subTest(checkNodeLayout<2>({64, 64}, {0, 1, 0, 1, 0, 1, 0, 1}));
+  t.subTest(checkNodeLayout<3>({32, 32, 32}, {3, 3, 3, 3, 7, 7, 7, 7, 5, 5, 5, 5, 1, 1, 1, 1}));
+  t.subTest(checkNodeLayout<3>({48, 16, 16}, std::vector<int>(12, 0)));
+  // uneven node sizes
+  t.subTest(checkNodeLayout<2>({64, 64}, {0, 0, 0, 1, 1}));
+
+  t.subTest(checkWeighted<1>({32}, 4));
+  t.subTest(checkWeighted<2>({32, 16}, 4));
+  t.subTest(checkWeighted<3>({32, 8, 8}, 8));
+
+  // a grid partitioned with unequal extents
+  {
+    Dune::YaspWeightedPartitioner<2> partitioner([](const std::array<int,2>& e) { return e[0] < 4 ? 20.0 : 1.0; });
+    Dune::FieldVector<double,2> len(1.0);
+    std::array<int,2> s = {{32, 12}};
+    std::bitset<2> periodic(0);
+    periodic[0] = true;
+    Dune::YaspGrid<2> grid(len, s, periodic, 1, Dune::MPIHelper::getCollectiveCommunication(), &partitioner);
+
+    int cells = 0;
+    for (const auto& element : elements(grid.leafGridView(), Dune::Partitions::interior))
+      cells += (element.partitionType() == Dune::InteriorEntity);
+    cells = grid.comm().sum(cells);
+    t.check(cells == 32*12) << "interiors do not partition the domain";
+
+    gridcheck(grid);
+    grid.globalRefine(1);
+    gridcheck(grid);
+  }
+
+#if HAVE_MPI
+  // a grid partitioned with the actual node layout
+  Dune::YaspNodeAwarePartitioner<2> partitioner(MPI_COMM_WORLD);
+  Dune::FieldVector<double,2> len(1.0);
+  std::array<int,2> s = {{16, 12}};
+  std::bitset<2> periodic(0);
+  periodic[0] = true;
+  Dune::YaspGrid<2> grid(len, s, periodic, 1, MPI_COMM_WORLD, &partitioner);
+
+  int cells = grid.leafGridView().size(0);
+  cells = grid.comm().sum(cells);
+  t.check(cells >= 16*12) << "grid does not cover the domain";
+
+  gridcheck(grid);
+  if (mpiHelper.rank() == 0)
+    std::cout << "nodes: " << partitioner.nodes() << std::endl;
+#endif
+
+  return t.exit();
+}
@@ -49,6 +49,21 @@ int main (int argc , char **argv) {
     check_yasp(testID + "tensor-generic-constructor",
                YaspFactory<2,Dune::TensorProductCoordinates<double,2> >::buildGrid(true,0,false,true));
 
+    // Exchange messages by neighborhood collectives
+    {
+      auto grid = YaspFactory<2,Dune::EquidistantCoordinates<double,2> >::buildGrid(true, 1);
+      grid->communicationOptions(true);
+      check_yasp(testID + "equidistant-neighbor-collectives", grid);
+    }
+
+    // Pass messages within a node through shared memory, with and without neighborhood collectives
+    for (int collectives = 0; collectives <= 1; ++collectives)
+    {
+      auto grid = YaspFactory<2,Dune::EquidistantCoordinates<double,2> >::buildGrid(true, 1);
+      grid->communicationOptions(collectives == 1, true);
+      check_yasp(testID + "equidistant-shared-memory" + std::to_string(collectives), grid);
+    }
+
     // And periodicity
 //    check_yasp(YaspFactory<2,Dune::EquidistantCoordinates<double,2> >::buildGrid(true, 0, true));
 //    check_yasp(YaspFactory<2,Dune::EquidistantOffsetCoordinates<double,2> >::buildGrid(true, 0, true));
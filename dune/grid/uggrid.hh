@@ -8,7 +8,11 @@
  * \brief The UGGrid class
  */
 
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <type_traits>
+#include <utility>
 
 #include <dune/common/classname.hh>
 #include <dune/common/parallel/collectivecommunication.hh>
@@ -19,6 +23,7 @@
 #include <dune/grid/common/boundarysegment.hh>
 #include <dune/grid/common/capabilities.hh>
 #include <dune/grid/common/grid.hh>
+#include <dune/grid/common/instrumentation.hh>
 
 #if HAVE_UG || DOXYGEN
 
@@ -127,6 +132,7 @@
 #ifdef ModelP
 #include "uggrid/ugmessagebuffer.hh"
 #include "uggrid/uglbgatherscatter.hh"
+#include "uggrid/uglbpackedtransfer.hh"
 #endif
 
 // Not needed here, but included for user convenience
@@ -141,6 +147,11 @@ DataHandle *Dune::UGMessageBufferBase<DataHandle,GridDim,codim>::duneDataHandle_
 
 template <class DataHandle, int GridDim, int codim>
 int Dune::UGMessageBufferBase<DataHandle,GridDim,codim>::level = -1;
+
+#if DUNE_GRID_INSTRUMENTATION
+template <class DataHandle, int GridDim, int codim>
+std::size_t Dune::UGMessageBufferBase<DataHandle,GridDim,codim>::gathered_ = 0;
+#endif
 #endif // ModelP
 
 namespace Dune {
@@ -537,29 +548,30 @@ namespace Dune {
      * \param[in,out] dataHandle A data handle object that does the gathering and scattering of data
      * \tparam DataHandle works like the data handle for the communicate methods.
      *
+     * Element and vertex data is packed into one buffer per target process and sent along
+     * with the grid (see UGLBPackedTransfer).  After load balancing, the data is scattered
+     * to the interior leaf elements and their vertices.
+     *
      * \return true
      */
     template<class DataHandle>
     bool loadBalance (const std::vector<Rank>& targetProcessors, unsigned int fromLevel, DataHandle& dataHandle)
     {
-#ifdef ModelP
-      // gather element data
-      //        UGLBGatherScatter::template gather<0>(this->leafGridView(), dataHandle);
+      // the transfer of the data is timed together with the load balancing itself
+      DUNE_GRID_INSTRUMENT_REGION(region, "UGGrid::loadBalance with data");
 
-      // gather node data
-      UGLBGatherScatter::template gather<dim>(this->leafGridView(), dataHandle);
+#ifdef ModelP
+      // pack the element and vertex data by target rank and send it
+      UGLBPackedTransfer<UGGrid<dim> > transfer;
+      transfer.gather(*this, targetProcessors, dataHandle);
+      DUNE_GRID_INSTRUMENT_BYTES(region, transfer.sentBytes());
 #endif
 
-      // the load balancing step now also attaches
-      // the data to the entities and distributes it
       loadBalance(targetProcessors,fromLevel);
 
 #ifdef ModelP
-      // scatter element data
-      //        UGLBGatherScatter::template scatter<0>(this->leafGridView(), dataHandle);
-
-      // scatter node data
-      UGLBGatherScatter::template scatter<dim>(this->leafGridView(), dataHandle);
+      // hand the received data to the entities of the new distribution
+      transfer.scatter(*this, dataHandle);
 #endif
 
       return true;
@@ -579,6 +591,8 @@ namespace Dune {
                         InterfaceType iftype,
                         CommunicationDirection dir) const
     {
+      DUNE_GRID_INSTRUMENT_REGION(region, "UGGrid::communicate", codim, iftype);
+
       typename UG_NS<dim>::DDD_IF_DIR ugIfDir;
       // Translate the communication direction from Dune-Speak to UG-Speak
       if (dir==ForwardCommunication)
@@ -594,10 +608,13 @@ namespace Dune {
       std::vector<typename UG_NS<dim>::DDD_IF> ugIfs;
       findDDDInterfaces_(ugIfs, iftype, codim);
 
-      unsigned bufSize = UGMsgBuf::ugBufferSize_(gv);
+      UGMsgBuf::grid_ = this;
+      unsigned bufSize = UGMsgBuf::ugBufferSize_(gv, communicationEntities_<codim>(gv, level));
       if (!bufSize)
         return;     // we don't need to communicate if we don't have any data!
-      UGMsgBuf::grid_ = this;
+#if DUNE_GRID_INSTRUMENTATION
+      UGMsgBuf::gathered_ = 0;
+#endif
       for (unsigned i=0; i < ugIfs.size(); ++i)
         UG_NS<dim>::DDD_IFOneway(
 #if DUNE_UGGRID_HAVE_DDDCONTEXT
@@ -608,6 +625,45 @@ namespace Dune {
                                  bufSize,
                                  &UGMsgBuf::ugGather_,
                                  &UGMsgBuf::ugScatter_);
+      // DDD sends a buffer of bufSize bytes for each gathered entity
+      DUNE_GRID_INSTRUMENT_BYTES(region, std::size_t(bufSize) * UGMsgBuf::gathered_);
+    }
+
+    /** \brief The UG objects of all codim entities of a grid view
+
+       Elements and vertices are taken from the entity iterators, edges and faces as
+       subentities of the elements.  The lists are kept until the grid changes.
+     */
+    template <int codim, class GridView>
+    const std::vector<void*>& communicationEntities_(const GridView& gv, int level) const
+    {
+      const auto key = std::make_pair(codim, level);
+      auto it = communicationEntityCache_.find(key);
+      if (it != communicationEntityCache_.end())
+        return it->second;
+
+      std::vector<void*>& ugEntities = communicationEntityCache_[key];
+      collectCommunicationEntities_<codim>(gv, ugEntities, std::integral_constant<bool, codim==0 || codim==dim>());
+      return ugEntities;
+    }
+
+    template <int codim, class GridView>
+    void collectCommunicationEntities_(const GridView& gv, std::vector<void*>& ugEntities, std::true_type) const
+    {
+      for (const auto& entity : entities(gv, Codim<codim>(), Dune::Partitions::all))
+        ugEntities.push_back(entity.impl().getTarget());
+    }
+
+    template <int codim, class GridView>
+    void collectCommunicationEntities_(const GridView& gv, std::vector<void*>& ugEntities, std::false_type) const
+    {
+      for (const auto& element : elements(gv, Dune::Partitions::all))
+        for (unsigned int k = 0; k < element.subEntities(codim); k++)
+          ugEntities.push_back(element.template subEntity<codim>(k).impl().getTarget());
+
+      // each edge or face is shared by several elements
+      std::sort(ugEntities.begin(), ugEntities.end());
+      ugEntities.erase(std::unique(ugEntities.begin(), ugEntities.end()), ugEntities.end());
     }
 
     void findDDDInterfaces_(std::vector<typename UG_NS<dim>::DDD_IF > &dddIfaces,
@@ -868,6 +924,20 @@ namespace Dune {
      */
     unsigned int numBoundarySegments_;
 
+    /** \brief Work array for the non-leaf elements of one level during loadBalance
+
+       Kept between calls to avoid reallocation on each rebalance.
+     */
+    std::vector<typename UG_NS<dim>::Element*> loadBalanceElements_;
+
+#ifdef ModelP
+    /** \brief The UG objects that communicate() looks at, for each codimension and level (-1 for the leaf level)
+
+       Cleared by setIndices(), i.e., whenever the grid changes.
+     */
+    mutable std::map<std::pair<int,int>, std::vector<void*> > communicationEntityCache_;
+#endif
+
   }; // end Class UGGrid
 
   namespace Capabilities
@@ -2,143 +2,238 @@
 // vi: set et ts=4 sw=2 sts=2:
 #include <config.h>
 
+#include <algorithm>
+#include <utility>
+
 #include <dune/grid/common/grid.hh>  // for the exceptions
 
 #include "boundaryextractor.hh"
 
 namespace Dune {
 
-void BoundaryExtractor::detectBoundarySegments(const std::vector<unsigned char>& elementTypes,
-                                               const std::vector<unsigned int>& elementVertices,
-                                               std::set<UGGridBoundarySegment<2> >& boundarySegments)
-{
-  // The vertices that form the edges of a triangle -- in UG numbering
-  static const int triIdx[][2] = {
-    {0,1},{1,2},{2,0}
+namespace {
+
+  // The vertices that form the faces of the elements -- in UG numbering.
+  // In 3d, double numbers mean the face is actually a triangle.
+  const int triIdx[][4] = {
+    {0,1,-1,-1},{1,2,-1,-1},{2,0,-1,-1}
   };
 
-  // The vertices that form the edges of a quadrilateral -- in UG numbering
-  static const int quadIdx[][2] = {
-    {0,1},{1,2},{2,3},{3,0}
+  const int quadIdx[][4] = {
+    {0,1,-1,-1},{1,2,-1,-1},{2,3,-1,-1},{3,0,-1,-1}
   };
 
-  boundarySegments.clear();
-  unsigned int currentBase = 0;
+  const int tetraIdx[][4] = {
+    {1,3,2,2},{0,2,3,3},{0,3,1,1},{0,1,2,2}
+  };
 
-  for (size_t i=0; i<elementTypes.size(); i++) {
+  const int pyramidIdx[][4] = {
+    {0,1,2,3},{0,4,1,1},{1,4,2,2},{3,2,4,4},{0,3,4,4}
+  };
 
-    int verticesPerElement = elementTypes[i];
+  const int prismIdx[][4] = {
+    {0,1,2,2},{0,3,4,1},{1,4,5,2},{0,2,5,3},{3,5,4,4}
+  };
 
-    for (int k=0; k<verticesPerElement; k++) {
+  const int hexaIdx[][4] = {
+    {0,4,5,1},{1,5,6,2},{2,6,7,3},{3,7,4,0},{4,7,6,5},{1,2,3,0}
+  };
 
-      UGGridBoundarySegment<2> v;
-      if (verticesPerElement==3) {
-        v[0] = elementVertices[currentBase+triIdx[k][0]];
-        v[1] = elementVertices[currentBase+triIdx[k][1]];
-      } else {
-        v[0] = elementVertices[currentBase+quadIdx[k][0]];
-        v[1] = elementVertices[currentBase+quadIdx[k][1]];
+  // The faces of an element with the given number of vertices
+  template <int dim>
+  const int (*faceIndices(int verticesPerElement, int& numFaces))[4]
+  {
+    if (dim==2) {
+      numFaces = verticesPerElement;
+      switch (verticesPerElement) {
+      case 3 : return triIdx;
+      case 4 : return quadIdx;
+      }
+    } else {
+      switch (verticesPerElement) {
+      case 4 : numFaces = 4; return tetraIdx;
+      case 5 : numFaces = 5; return pyramidIdx;
+      case 6 : numFaces = 5; return prismIdx;
+      case 8 : numFaces = 6; return hexaIdx;
       }
-
-      // Check if new face exists already in the list
-      // (then it is no boundary face)
-      std::pair<std::set<UGGridBoundarySegment<2> >::iterator,bool> status = boundarySegments.insert(v);
-      if (!status.second)         //  Not inserted because already existing
-        boundarySegments.erase(status.first);
-
     }
+    DUNE_THROW(Exception, "Can't handle elements with " << verticesPerElement << " vertices!");
+  }
 
-    currentBase += verticesPerElement;
+  // A face of an element, identified by its vertices independent of their order
+  struct ElementFace
+  {
+    // The sorted vertices, padded with -1.  Ascending in 2d and descending in 3d,
+    // to compare in the same way as UGGridBoundarySegment::operator<.
+    std::array<int,4> key;
+    unsigned int element;
+    unsigned int face;
+
+    bool operator<(const ElementFace& other) const
+    {
+      // triangles before quadrilaterals
+      if ((key[3]==-1) != (other.key[3]==-1))
+        return key[3]==-1;
+      if (key != other.key)
+        return key < other.key;
+      if (element != other.element)
+        return element < other.element;
+      return face < other.face;
+    }
+  };
 
+  // The vertices of a face in the orientation given by the element
+  inline void fillSegment(const unsigned int* vertices, const int* idx, UGGridBoundarySegment<2>& v)
+  {
+    v[0] = vertices[idx[0]];
+    v[1] = vertices[idx[1]];
   }
 
-}
+  inline void fillSegment(const unsigned int* vertices, const int* idx, UGGridBoundarySegment<3>& v)
+  {
+    for (int j=0; j<4; j++)
+      v[j] = vertices[idx[j]];
 
-void BoundaryExtractor::detectBoundarySegments(const std::vector<unsigned char>& elementTypes,
-                                               const std::vector<unsigned int>& elementVertices,
-                                               std::set<UGGridBoundarySegment<3> >& boundarySegments)
-{
-  int numElements = elementTypes.size();
+    // Check whether the faces is degenerated to a triangle
+    if (v[2]==v[3])
+      v[3] = -1;
+  }
 
-  // The vertices that form the faces of a tetrahedron -- in UG numbering
-  // Double numbers mean the face is actually a triangle
-  static const int tetraIdx[][4] = {
-    {1,3,2,2},{0,2,3,3},{0,3,1,1},{0,1,2,2}
-  };
+  inline std::array<int,4> faceKey(const UGGridBoundarySegment<2>& v)
+  {
+    return {{std::min(v[0], v[1]), std::max(v[0], v[1]), -1, -1}};
+  }
 
-  // The vertices that form the faces of a pyramid -- in UG numbering
-  static const int pyramidIdx[][4] = {
-    {0,1,2,3},{0,4,1,1},{1,4,2,2},{3,2,4,4},{0,3,4,4}
-  };
+  inline std::array<int,4> faceKey(const UGGridBoundarySegment<3>& v)
+  {
+    // insertion sort, which is fastest for three or four entries
+    std::array<int,4> key = v;
+    for (int i=1; i<v.numVertices(); i++)
+      for (int j=i; j>0 && key[j-1]<key[j]; j--)
+        std::swap(key[j-1], key[j]);
+    return key;
+  }
 
-  // The vertices that form the faces of a prism -- in UG numbering
-  static const int prismIdx[][4] = {
-    {0,1,2,2},{0,3,4,1},{1,4,5,2},{0,2,5,3},{3,5,4,4}
-  };
+  // The smallest vertex of a face
+  inline int smallestVertex(const std::array<int,4>& key)
+  {
+    int vertex = key[0];
+    for (int j=1; j<4; j++)
+      if (key[j]!=-1)
+        vertex = std::min(vertex, key[j]);
+    return vertex;
+  }
 
-  // The vertices that form the faces of a hexahedron -- in UG numbering
-  static const int hexaIdx[][4] = {
-    {0,4,5,1},{1,5,6,2},{2,6,7,3},{3,7,4,0},{4,7,6,5},{1,2,3,0}
-  };
+} // end anonymous namespace
 
-  // Number of faces for tetrahedra, pyramids, prisms, hexahedra
-  // The zeros are just fill-in.
-  static const int numFaces[9] = {0,0,0,0,4,5,5,0,6};
+template <int dim>
+void BoundaryExtractor::detectBoundarySegmentsImpl(const std::vector<unsigned char>& elementTypes,
+                                                   const std::vector<unsigned int>& elementVertices,
+                                                   std::vector<UGGridBoundarySegment<dim> >& boundarySegments)
+{
+  const std::size_t numElements = elementTypes.size();
   boundarySegments.clear();
 
-  // An index into the list of element vertices pointing to the current element
-  int currentElement = 0;
-
-  for (int i=0; i<numElements; i++) {
-
-    for (int k=0; k<numFaces[elementTypes[i]]; k++) {
-
-      UGGridBoundarySegment<3> v;
-
-      switch (elementTypes[i]) {
-      case 4 :       // tetrahedron
-        for (int j=0; j<4; j++)
-          v[j] = elementVertices[currentElement+tetraIdx[k][j]];
-        break;
-      case 5 :       // pyramid
-        for (int j=0; j<4; j++)
-          v[j] = elementVertices[currentElement+pyramidIdx[k][j]];
-        break;
-      case 6 :       // prism
-        for (int j=0; j<4; j++)
-          v[j] = elementVertices[currentElement+prismIdx[k][j]];
-        break;
-      case 8 :       // hexahedron
-        for (int j=0; j<4; j++)
-          v[j] = elementVertices[currentElement+hexaIdx[k][j]];
-        break;
-      default :
-        DUNE_THROW(Exception, "Can't handle elements with " << elementTypes[i] << " vertices!");
+  if (numElements == 0)
+    return;
+
+  const std::size_t numVertices = *std::max_element(elementVertices.begin(), elementVertices.end()) + 1;
+
+  // Offsets of the vertices of each element
+  std::vector<std::size_t> vertexOffsets(numElements+1);
+  vertexOffsets[0] = 0;
+  for (std::size_t i=0; i<numElements; i++)
+    vertexOffsets[i+1] = vertexOffsets[i] + elementTypes[i];
+
+  // Call f(face) for each face of each element
+  auto forEachFace = [&](auto&& f) {
+    ElementFace face;
+    for (std::size_t i=0; i<numElements; i++) {
+      int numFaces;
+      const int (*idx)[4] = faceIndices<dim>(elementTypes[i], numFaces);
+      for (int k=0; k<numFaces; k++) {
+        UGGridBoundarySegment<dim> v;
+        fillSegment(&elementVertices[vertexOffsets[i]], idx[k], v);
+        face.key = faceKey(v);
+        face.element = i;
+        face.face = k;
+        f(face);
       }
+    }
+  };
 
-      // Check whether the faces is degenerated to a triangle
-      if (v[2]==v[3])
-        v[3] = -1;
-
-      // Find out if the element face has already been encountered.  Then it is not a boundary face.
-      std::pair<std::set<UGGridBoundarySegment<3> >::iterator,bool> status = boundarySegments.insert(v);
-
-      if (!status.second) {           //  Not inserted because already existing
-
-        boundarySegments.erase(status.first);
-
-      }
+  // Bucket the faces by their smallest vertex.  Matching faces end up in the
+  // same bucket, and the buckets are small.
+  std::vector<std::size_t> bucketOffsets(numVertices+1, 0);
+  forEachFace([&](const ElementFace& face) {
+    bucketOffsets[smallestVertex(face.key)+1]++;
+  });
+  for (std::size_t i=0; i<numVertices; i++)
+    bucketOffsets[i+1] += bucketOffsets[i];
+
+  std::vector<ElementFace> faces(bucketOffsets[numVertices]);
+  {
+    std::vector<std::size_t> position(bucketOffsets.begin(), bucketOffsets.end()-1);
+    forEachFace([&](const ElementFace& face) {
+      faces[position[smallestVertex(face.key)]++] = face;
+    });
+  }
 
+  // Faces shared by an even number of elements are interior faces.  As before,
+  // the orientation of a boundary face is taken from its last occurrence.
+  std::vector<char> isBoundaryFace(faces.size(), false);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+  for (std::size_t bucket=0; bucket<numVertices; bucket++) {
+    const auto first = faces.begin() + bucketOffsets[bucket];
+    const auto last = faces.begin() + bucketOffsets[bucket+1];
+    std::sort(first, last);
+
+    for (auto begin = first; begin != last; ) {
+      auto end = begin+1;
+      while (end != last && end->key == begin->key)
+        ++end;
+      if ((end-begin)%2 == 1)
+        isBoundaryFace[(end-1) - faces.begin()] = true;
+      begin = end;
     }
+  }
 
-    currentElement += elementTypes[i];
-
+  // Sort the boundary faces in the order of UGGridBoundarySegment::operator<
+  std::vector<ElementFace> boundaryFaces;
+  for (std::size_t i=0; i<faces.size(); i++)
+    if (isBoundaryFace[i])
+      boundaryFaces.push_back(faces[i]);
+  std::vector<ElementFace>().swap(faces);
+  std::sort(boundaryFaces.begin(), boundaryFaces.end());
+
+  boundarySegments.resize(boundaryFaces.size());
+  for (std::size_t i=0; i<boundaryFaces.size(); i++) {
+    const ElementFace& face = boundaryFaces[i];
+    int numFaces;
+    const int (*idx)[4] = faceIndices<dim>(elementTypes[face.element], numFaces);
+    fillSegment(&elementVertices[vertexOffsets[face.element]], idx[face.face], boundarySegments[i]);
   }
+}
+
+void BoundaryExtractor::detectBoundarySegments(const std::vector<unsigned char>& elementTypes,
+                                               const std::vector<unsigned int>& elementVertices,
+                                               std::vector<UGGridBoundarySegment<2> >& boundarySegments)
+{
+  detectBoundarySegmentsImpl<2>(elementTypes, elementVertices, boundarySegments);
+}
 
+void BoundaryExtractor::detectBoundarySegments(const std::vector<unsigned char>& elementTypes,
+                                               const std::vector<unsigned int>& elementVertices,
+                                               std::vector<UGGridBoundarySegment<3> >& boundarySegments)
+{
+  detectBoundarySegmentsImpl<3>(elementTypes, elementVertices, boundarySegments);
 }
 
 template<int dim>
-int BoundaryExtractor::detectBoundaryNodes(const std::set<UGGridBoundarySegment<dim> >& boundarySegments,
+int BoundaryExtractor::detectBoundaryNodes(const std::vector<UGGridBoundarySegment<dim> >& boundarySegments,
                                            int noOfNodes,
                                            std::vector<int>& isBoundaryNode)
 {
@@ -169,11 +264,11 @@ int BoundaryExtractor::detectBoundaryNodes(const std::set<UGGridBoundarySegment<
 //   can have in 2d and 3d, respectively.
 // //////////////////////////////////////////////////////////////////////////////
 
-template int BoundaryExtractor::detectBoundaryNodes<2>(const std::set<UGGridBoundarySegment<2> >& boundarySegments,
+template int BoundaryExtractor::detectBoundaryNodes<2>(const std::vector<UGGridBoundarySegment<2> >& boundarySegments,
                                                        int noOfNodes,
                                                        std::vector<int>& isBoundaryNode);
 
-template int BoundaryExtractor::detectBoundaryNodes<3>(const std::set<UGGridBoundarySegment<3> >& boundarySegments,
+template int BoundaryExtractor::detectBoundaryNodes<3>(const std::vector<UGGridBoundarySegment<3> >& boundarySegments,
                                                        int noOfNodes,
                                                        std::vector<int>& isBoundaryNode);
 
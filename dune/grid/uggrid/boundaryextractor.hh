@@ -10,7 +10,6 @@
 
 #include <iostream>
 #include <vector>
-#include <set>
 #include <array>
 
 
@@ -134,27 +133,36 @@ namespace Dune {
   }
 
   /** \brief Extracts the boundary faces and nodes from a set grid given as a set of elements
+
+     The faces of all elements are sorted by their vertices.  Faces that occur
+     an odd number of times are boundary faces.  The resulting boundary segments
+     are sorted with respect to UGGridBoundarySegment::operator<, such that
+     they can be found by binary search.
    */
   class BoundaryExtractor {
 
-    typedef std::set<UGGridBoundarySegment<2> >::iterator SetIterator2d;
-    typedef std::set<UGGridBoundarySegment<3> >::iterator SetIterator3d;
-
   public:
 
     static void detectBoundarySegments(const std::vector<unsigned char>& elementTypes,
                                        const std::vector<unsigned int>& elementVertices,
-                                       std::set<UGGridBoundarySegment<2> >& boundarySegments);
+                                       std::vector<UGGridBoundarySegment<2> >& boundarySegments);
 
     static void detectBoundarySegments(const std::vector<unsigned char>& elementTypes,
                                        const std::vector<unsigned int>& elementVertices,
-                                       std::set<UGGridBoundarySegment<3> >& boundarySegments);
+                                       std::vector<UGGridBoundarySegment<3> >& boundarySegments);
 
     template <int dim>
-    static int detectBoundaryNodes(const std::set<UGGridBoundarySegment<dim> >& boundarySegments,
+    static int detectBoundaryNodes(const std::vector<UGGridBoundarySegment<dim> >& boundarySegments,
                                    int noOfNodes,
                                    std::vector<int>& isBoundaryNode);
 
+  private:
+
+    template <int dim>
+    static void detectBoundarySegmentsImpl(const std::vector<unsigned char>& elementTypes,
+                                           const std::vector<unsigned int>& elementVertices,
+                                           std::vector<UGGridBoundarySegment<dim> >& boundarySegments);
+
   };
 
 }
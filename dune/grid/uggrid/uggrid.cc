@@ -3,9 +3,10 @@
 
 #include <config.h>
 
+#include <array>
 #include <set>
-#include <map>
 #include <memory>
+#include <utility>
 
 #include <dune/grid/uggrid.hh>
 
@@ -289,6 +290,8 @@ bool UGGrid <dim>::preAdapt()
 template < int dim >
 bool UGGrid < dim >::adapt()
 {
+  DUNE_GRID_INSTRUMENT_REGION(region, "UGGrid::adapt");
+
   assert(multigrid_);
 
   // Set UG's currBVP variable to the BVP corresponding to this
@@ -446,6 +449,8 @@ void UGGrid<dim>::getChildrenOfSubface(const typename Traits::template Codim<0>:
 template < int dim >
 bool UGGrid < dim >::loadBalance(int minlevel)
 {
+  DUNE_GRID_INSTRUMENT_REGION(region, "UGGrid::loadBalance");
+
   // Do nothing if we are on a single process
   if (comm().size()==1)
     return true;
@@ -465,6 +470,8 @@ bool UGGrid < dim >::loadBalance(int minlevel)
 template < int dim >
 bool UGGrid < dim >::loadBalance(const std::vector<Rank>& targetProcessors, unsigned int fromLevel)
 {
+  DUNE_GRID_INSTRUMENT_REGION(region, "UGGrid::loadBalance");
+
   // Do nothing if we are on a single process
   if (comm().size()==1)
     return true;
@@ -477,49 +484,66 @@ bool UGGrid < dim >::loadBalance(const std::vector<Rank>& targetProcessors, unsi
   typedef MultipleCodimMultipleGeomTypeMapper<typename Base::LeafGridView> ElementMapper;
   ElementMapper elementMapper(this->leafGridView(), mcmgElementLayout());
 
-  // Loop over all elements of all level, in decreasing level number.
-  // If the element is a leaf, take its target rank from the input targetProcessors array.
-  // If it is not, assign it to the processor most of its children are assigned to.
-  for (int i=maxLevel(); i>=0; i--) {
-    for (const auto& element : elements(this->levelGridView(i), Partitions::interior)) {
+  // Each leaf element takes its target rank from the input targetProcessors array.
+  for (const auto& element : elements(this->leafGridView(), Partitions::interior)) {
 
-      if (element.isLeaf()) {
+    int targetRank = targetProcessors[elementMapper.index(element)];
 
-        int targetRank = targetProcessors[elementMapper.index(element)];
+    // sanity check
+    if (targetRank >= comm().size())
+      DUNE_THROW(GridError, "Requesting target processor " << targetRank <<
+                 ", but only " << comm().size() << " processors are available.");
 
-        // sanity check
-        if (targetRank >= comm().size())
-          DUNE_THROW(GridError, "Requesting target processor " << targetRank <<
-                     ", but only " << comm().size() << " processors are available.");
+    UG_NS<dim>::Partition(element.impl().target_) = targetRank;
+  }
 
-        UG_NS<dim>::Partition(element.impl().target_) = targetRank;
-      } else {
+  // Loop over the non-leaf elements of all levels, in decreasing level number,
+  // and assign each to the processor most of its children are assigned to.
+  // The elements of one level only read the ranks of the level above,
+  // hence they can be processed independently.
+  for (int i=maxLevel(); i>=0; i--) {
 
-        std::map<Rank,unsigned int> rank;
-        Rank mostFrequentRank = 0;    // which rank occurred most often?
-        unsigned int mostFrequentCount = 0;   // how often did it occur?
+    loadBalanceElements_.clear();
+    for (const auto& element : elements(this->levelGridView(i), Partitions::interior))
+      if (!element.isLeaf())
+        loadBalanceElements_.push_back(element.impl().target_);
 
-        // Loop over all children and collect the ranks they are assigned to
-        for (const auto& child : descendantElements(element, element.level() + 1)) {
+    const int n = loadBalanceElements_.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int k=0; k<n; k++) {
 
-          auto childRank = UG_NS<dim>::Partition(child.impl().target_);
+      typename UG_NS<dim>::Element* target = loadBalanceElements_[k];
+      typename UG_NS<dim>::Element* sonList[UG_NS<dim>::MAX_SONS];
+      UG_NS<dim>::GetSons(target, sonList);
 
-          if (rank.find(childRank) == rank.end())
-            rank[childRank] = 1;
-          else
-            rank[childRank]++;
+      // Vote on the ranks of the children.  There cannot be more distinct ranks than children.
+      // The children are visited in the order of the hierarchic iterator, which decides ties.
+      std::array<std::pair<Rank,unsigned int>, UG_NS<dim>::MAX_SONS> votes;
+      int numVotes = 0;
+      Rank mostFrequentRank = 0;    // which rank occurred most often?
+      unsigned int mostFrequentCount = 0;   // how often did it occur?
 
-          if (rank[childRank] > mostFrequentCount) {
-            mostFrequentRank = childRank;
-            mostFrequentCount = rank[childRank];
-          }
+      for (int j=UG_NS<dim>::nSons(target)-1; j>=0; j--) {
 
-        }
+        const Rank childRank = UG_NS<dim>::Partition(sonList[j]);
+
+        int v = 0;
+        while (v < numVotes && votes[v].first != childRank)
+          v++;
+        if (v == numVotes)
+          votes[numVotes++] = std::make_pair(childRank, 0u);
 
-        // Assign rank that occurred most often
-        UG_NS<dim>::Partition(element.impl().target_) = mostFrequentRank;
+        if (++votes[v].second > mostFrequentCount) {
+          mostFrequentRank = childRank;
+          mostFrequentCount = votes[v].second;
+        }
 
       }
+
+      // Assign rank that occurred most often
+      UG_NS<dim>::Partition(target) = mostFrequentRank;
     }
   }
 #endif
@@ -638,6 +662,11 @@ void UGGrid < dim >::setIndices(bool setLevelZero,
   leafIndexSet_.update(nodePermutation);
 
   // id sets don't need updating
+
+#ifdef ModelP
+  // the entities taking part in communication have changed
+  communicationEntityCache_.clear();
+#endif
 }
 
 // /////////////////////////////////////////////////////////////////////////////////
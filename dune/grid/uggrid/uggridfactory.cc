@@ -3,6 +3,8 @@
 
 #include <config.h>
 
+#include <algorithm>
+#include <array>
 #include <memory>
 
 #include <dune/common/std/memory.hh>
@@ -111,75 +113,128 @@ insertVertex(const FieldVector<typename GridFactory<UGGrid<dimworld> >::ctype,di
 }
 
 template <int dimworld>
-void GridFactory<UGGrid<dimworld> >::
-insertElement(const GeometryType& type,
-              const std::vector<unsigned int>& vertices)
+const std::array<unsigned char, 8>& GridFactory<UGGrid<dimworld> >::
+vertexPermutation(const GeometryType& type, std::size_t numVertices)
 {
+  // DUNE and UG numberings differ for quadrilaterals, pyramids and hexahedra
+  static const std::array<unsigned char, 8> identity = {{0, 1, 2, 3, 4, 5, 6, 7}};
+  static const std::array<unsigned char, 8> swap23 = {{0, 1, 3, 2, 4, 5, 6, 7}};
+  static const std::array<unsigned char, 8> swap23and67 = {{0, 1, 3, 2, 4, 5, 7, 6}};
+
   if (dimworld!=type.dim())
     DUNE_THROW(GridError, "You cannot insert a " << type
                                                  << " into a UGGrid<" << dimworld << ">!");
 
-  int newIdx = elementVertices_.size();
-
-  elementTypes_.push_back(vertices.size());
-  for (unsigned int i=0; i<vertices.size(); i++)
-    elementVertices_.push_back(vertices[i]);
+  const char* name = nullptr;
+  std::size_t expected = 0;
+  const std::array<unsigned char, 8>* permutation = &identity;
 
   if (type.isTriangle()) {
-    // Everything alright
-    if (vertices.size() != 3)
-      DUNE_THROW(GridError, "You have requested to enter a triangle, but you"
-                 << " have provided " << vertices.size() << " vertices!");
-
+    name = "a triangle";
+    expected = 3;
   } else if (type.isQuadrilateral()) {
-
-    if (vertices.size() != 4)
-      DUNE_THROW(GridError, "You have requested to enter a quadrilateral, but you"
-                 << " have provided " << vertices.size() << " vertices!");
-
-    // DUNE and UG numberings differ --> reorder the vertices
-    elementVertices_[newIdx+2] = vertices[3];
-    elementVertices_[newIdx+3] = vertices[2];
-
+    name = "a quadrilateral";
+    expected = 4;
+    permutation = &swap23;
   } else if (type.isTetrahedron()) {
-
-    if (vertices.size() != 4)
-      DUNE_THROW(GridError, "You have requested to enter a tetrahedron, but you"
-                 << " have provided " << vertices.size() << " vertices!");
-
+    name = "a tetrahedron";
+    expected = 4;
   } else if (type.isPyramid()) {
+    name = "a pyramid";
+    expected = 5;
+    permutation = &swap23;
+  } else if (type.isPrism()) {
+    name = "a prism";
+    expected = 6;
+  } else if (type.isHexahedron()) {
+    name = "a hexahedron";
+    expected = 8;
+    permutation = &swap23and67;
+  } else {
+    DUNE_THROW(GridError, "You cannot insert a " << type
+                                                 << " into a UGGrid<" << dimworld << ">!");
+  }
 
-    if (vertices.size() != 5)
-      DUNE_THROW(GridError, "You have requested to enter a pyramid, but you"
-                 << " have provided " << vertices.size() << " vertices!");
+  if (numVertices != expected)
+    DUNE_THROW(GridError, "You have requested to enter " << name << ", but you"
+               << " have provided " << numVertices << " vertices!");
 
-    // DUNE and UG numberings differ --> reorder the vertices
-    elementVertices_[newIdx+2] = vertices[3];
-    elementVertices_[newIdx+3] = vertices[2];
+  return *permutation;
+}
 
-  } else if (type.isPrism()) {
+template <int dimworld>
+void GridFactory<UGGrid<dimworld> >::
+appendElements(const GeometryType& type, const unsigned int* vertices,
+               std::size_t numVertices, std::size_t numElements)
+{
+  const auto& permutation = vertexPermutation(type, numVertices);
 
-    if (vertices.size() != 6)
-      DUNE_THROW(GridError, "You have requested to enter a prism, but you"
-                 << " have provided " << vertices.size() << " vertices!");
+  elementTypes_.insert(elementTypes_.end(), numElements, numVertices);
 
-  } else if (type.isHexahedron()) {
+  std::size_t newIdx = elementVertices_.size();
+  elementVertices_.resize(newIdx + numElements*numVertices);
+  for (std::size_t i=0; i<numElements; i++, newIdx += numVertices, vertices += numVertices)
+    for (std::size_t j=0; j<numVertices; j++)
+      elementVertices_[newIdx+j] = vertices[permutation[j]];
+}
 
-    if (vertices.size() != 8)
-      DUNE_THROW(GridError, "You have requested to enter a hexahedron, but you"
-                 << " have provided " << vertices.size() << " vertices!");
+template <int dimworld>
+void GridFactory<UGGrid<dimworld> >::
+insertElement(const GeometryType& type,
+              const std::vector<unsigned int>& vertices)
+{
+  appendElements(type, vertices.data(), vertices.size(), 1);
+}
 
-    // DUNE and UG numberings differ --> reorder the vertices
-    elementVertices_[newIdx+2] = vertices[3];
-    elementVertices_[newIdx+3] = vertices[2];
-    elementVertices_[newIdx+6] = vertices[7];
-    elementVertices_[newIdx+7] = vertices[6];
+template <int dimworld>
+void GridFactory<UGGrid<dimworld> >::
+reserve(std::size_t numVertices, std::size_t numElements)
+{
+  vertexPositions_.reserve(numVertices);
+  elementTypes_.reserve(numElements);
+  // assume simplices, the array grows if needed
+  elementVertices_.reserve(numElements*(dimworld+1));
+}
 
-  } else {
+template <int dimworld>
+void GridFactory<UGGrid<dimworld> >::
+insertVertices(const ctype* coordinates, std::size_t numVertices)
+{
+  std::size_t first = vertexPositions_.size();
+  vertexPositions_.resize(first + numVertices);
+  for (std::size_t i=0; i<numVertices; i++)
+    for (int k=0; k<dimworld; k++)
+      vertexPositions_[first+i][k] = coordinates[i*dimworld+k];
+}
+
+template <int dimworld>
+void GridFactory<UGGrid<dimworld> >::
+insertElements(const GeometryType& type, const unsigned int* vertices, std::size_t numElements)
+{
+  // there is no reference element to take the number of vertices from otherwise
+  if (dimworld!=type.dim() || type.isNone())
     DUNE_THROW(GridError, "You cannot insert a " << type
                                                  << " into a UGGrid<" << dimworld << ">!");
-  }
 
+  const std::size_t numVertices = ReferenceElements<ctype,dimworld>::general(type).size(dimworld);
+  appendElements(type, vertices, numVertices, numElements);
+}
+
+template <int dimworld>
+void GridFactory<UGGrid<dimworld> >::
+insertElements(const GeometryType* types, const unsigned int* vertices,
+               const std::size_t* offsets, std::size_t numElements)
+{
+  // insert runs of elements of the same type in one go
+  std::size_t i = 0;
+  while (i < numElements)
+  {
+    std::size_t j = i+1;
+    while (j < numElements && types[j] == types[i] && offsets[j+1]-offsets[j] == offsets[i+1]-offsets[i])
+      j++;
+    appendElements(types[i], vertices + offsets[i], offsets[i+1]-offsets[i], j-i);
+    i = j;
+  }
 }
 
 template <int dimworld>
@@ -262,8 +317,7 @@ createGrid()
   // ///////////////////////////////////////////
   //   Extract grid boundary segments
   // ///////////////////////////////////////////
-  std::set<UGGridBoundarySegment<dimworld> > boundarySegments;
-  typedef typename std::set<UGGridBoundarySegment<dimworld> >::iterator SetIterator;
+  std::vector<UGGridBoundarySegment<dimworld> > boundarySegments;
 
   BoundaryExtractor::detectBoundarySegments(elementTypes_, elementVertices_, boundarySegments);
   if (boundarySegments.empty())
@@ -316,6 +370,7 @@ createGrid()
   // ///////////////////////////////////////////
   //   Insert the boundary segments
   // ///////////////////////////////////////////
+  std::vector<bool> isParametrized(boundarySegments.size(), false);
   unsigned int i;
   for (i=0; i<grid_->boundarySegments_.size(); i++) {
 
@@ -388,7 +443,7 @@ createGrid()
     }
 
     // /////////////////////////////////////////////////////////////////////
-    //   Remove this segment from the set of computed boundary segments.
+    //   Mark this segment in the sorted list of computed boundary segments.
     // /////////////////////////////////////////////////////////////////////
 
     UGGridBoundarySegment<dimworld> thisSegment;
@@ -396,27 +451,29 @@ createGrid()
     for (int j=0; j<2*dimworld-2; j++)
       thisSegment[j] = boundarySegmentVertices_[i][j];
 
-    SetIterator boundaryElementFace = boundarySegments.find(thisSegment);
+    auto boundaryElementFace = std::lower_bound(boundarySegments.begin(), boundarySegments.end(), thisSegment);
 
-    if (boundaryElementFace==boundarySegments.end())
+    if (boundaryElementFace==boundarySegments.end() || thisSegment < *boundaryElementFace
+        || isParametrized[boundaryElementFace - boundarySegments.begin()])
       DUNE_THROW(GridError, "You have provided a boundary parametrization for"
                  << " a segment which is not boundary segment in the grid!");
 
-    // Everything is fine.  Delete the element face from the list to mark that it has been properly handled
-    boundarySegments.erase(thisSegment);
+    // Everything is fine.  Mark the element face to show that it has been properly handled
+    isParametrized[boundaryElementFace - boundarySegments.begin()] = true;
   }
 
 
   // ///////////////////////////////////////////////////////////////////////
-  //   The boundary segments remaining in the std::set boundarySegments
-  //   have not been provided with an explicit parametrization.  They are
-  //   inserted into the domain as straight boundary segments.
+  //   The boundary segments not marked in isParametrized have not been
+  //   provided with an explicit parametrization.  They are inserted into
+  //   the domain as straight boundary segments.
   // ///////////////////////////////////////////////////////////////////////
-  SetIterator it = boundarySegments.begin();
+  for (std::size_t segment=0; segment<boundarySegments.size(); segment++) {
 
-  for (; it != boundarySegments.end(); ++it, ++i) {
+    if (isParametrized[segment])
+      continue;
 
-    const UGGridBoundarySegment<dimworld>& thisSegment = *it;
+    const UGGridBoundarySegment<dimworld>& thisSegment = boundarySegments[segment];
 
     // Copy the vertices into a C-style array
     int vertices_c_style[4];
@@ -444,6 +501,7 @@ createGrid()
                                              )==nullptr)
       DUNE_THROW(IOError, "Error calling CreateLinearSegment");
 
+    i++;
   }
 
 
@@ -197,6 +197,19 @@ namespace Dune {
     virtual void insertElement(const GeometryType& type,
                                const std::vector<unsigned int>& vertices);
 
+    /** \brief Reserve memory for the given numbers of vertices and elements */
+    virtual void reserve(std::size_t numVertices, std::size_t numElements);
+
+    /** \brief Insert several vertices into the coarse grid at once */
+    virtual void insertVertices(const ctype* coordinates, std::size_t numVertices);
+
+    /** \brief Insert several elements of the same type into the coarse grid at once */
+    virtual void insertElements(const GeometryType& type, const unsigned int* vertices, std::size_t numElements);
+
+    /** \brief Insert several elements of possibly different types into the coarse grid at once */
+    virtual void insertElements(const GeometryType* types, const unsigned int* vertices,
+                                const std::size_t* offsets, std::size_t numElements);
+
     /** \brief Method to insert a boundary segment into a coarse grid
 
        Using this method is optional.  It only influences the ordering of the segments
@@ -280,6 +293,13 @@ namespace Dune {
     // Initialize the grid structure in UG
     void createBegin();
 
+    // Check the number of vertices of an element type and return the UG vertex permutation
+    static const std::array<unsigned char, 8>& vertexPermutation(const GeometryType& type, std::size_t numVertices);
+
+    // Append elements of the same type to elementTypes_ and elementVertices_
+    void appendElements(const GeometryType& type, const unsigned int* vertices,
+                        std::size_t numVertices, std::size_t numElements);
+
     // Pointer to the grid being built
     UGGrid<dimworld>* grid_;
 
@@ -7,6 +7,7 @@
     \brief The index and id sets for the UGGrid class
  */
 
+#include <type_traits>
 #include <vector>
 #include <set>
 
@@ -16,11 +17,57 @@
 
 namespace Dune {
 
+  namespace Impl {
+
+    /* The indices of all subentities of codimension codim of a UGGrid element.
+     * The function index returns the level or leaf index of a UG object.  The
+     * UG element, its geometry type and its reference element are looked up
+     * once for all subentities.
+     */
+    template<int dim, class Element, class IndexFunction, class SubIndices>
+    void ugGridSubIndices (const Element& e, unsigned int codim, const IndexFunction& index, SubIndices& result)
+    {
+      const auto target = e.impl().getTarget();
+      const GeometryType type = e.type();
+      const auto refElement = referenceElement<double,dim>(type);
+
+      const int size = refElement.size(codim);
+      result.resize(size);
+
+      if (codim==0)
+        result[0] = index(target);
+      else if (codim==dim)
+      {
+        for (int i=0; i<size; i++)
+          result[i] = index(UG_NS<dim>::Corner(target, UGGridRenumberer<dim>::verticesDUNEtoUG(i,type)));
+      }
+      else if (codim==dim-1)
+      {
+        for (int i=0; i<size; i++)
+        {
+          auto a = refElement.subEntity(i,dim-1,0,dim);
+          auto b = refElement.subEntity(i,dim-1,1,dim);
+          result[i] = index(UG_NS<dim>::GetEdge(UG_NS<dim>::Corner(target, UGGridRenumberer<dim>::verticesDUNEtoUG(a,type)),
+                                                UG_NS<dim>::Corner(target, UGGridRenumberer<dim>::verticesDUNEtoUG(b,type))));
+        }
+      }
+      else
+      {
+        // faces of a 3d element
+        for (int i=0; i<size; i++)
+          result[i] = index(UG_NS<dim>::SideVector(target, UGGridRenumberer<dim>::facesDUNEtoUG(i,type)));
+      }
+    }
+
+  } // namespace Impl
+
   template<class GridImp>
   class UGGridLevelIndexSet : public IndexSet<GridImp,UGGridLevelIndexSet<GridImp>, UG::UINT>
   {
     enum {dim = GridImp::dimension};
 
+    typedef IndexSet<GridImp,UGGridLevelIndexSet<GridImp>, UG::UINT> Base;
+
   public:
 
     /** \brief Default constructor
@@ -158,6 +205,17 @@ namespace Dune {
       return result;
     }
 
+    /** \brief Get the indices of all subentities of codimension codim of an element */
+    template<int cc>
+    std::enable_if_t<cc==0, typename Base::SubIndices>
+    subIndices (const typename GridImp::Traits::template Codim<cc>::Entity& e,
+                unsigned int codim) const
+    {
+      typename Base::SubIndices result;
+      Impl::ugGridSubIndices<dim>(e, codim, [](const auto* object) { return UG_NS<dim>::levelIndex(object); }, result);
+      return result;
+    }
+
     //! get number of entities of given codim, type and on this level
     int size (int codim) const {
       if (codim==0)
@@ -248,6 +306,8 @@ namespace Dune {
   template<class GridImp>
   class UGGridLeafIndexSet : public IndexSet<GridImp,UGGridLeafIndexSet<GridImp>, UG::UINT>
   {
+    typedef IndexSet<GridImp,UGGridLeafIndexSet<GridImp>, UG::UINT> Base;
+
   public:
 
     /*
@@ -381,6 +441,21 @@ namespace Dune {
       return result;
     }
 
+    //! get indices of all subentities of codimension codim of an element
+    /*
+       We use the remove_const to extract the Type from the mutable class,
+       because the const class is not instantiated yet.
+     */
+    template<int cc>
+    std::enable_if_t<cc==0, typename Base::SubIndices>
+    subIndices (const typename std::remove_const<GridImp>::type::Traits::template Codim<cc>::Entity& e,
+                unsigned int codim) const
+    {
+      typename Base::SubIndices result;
+      Impl::ugGridSubIndices<dim>(e, codim, [](const auto* object) { return UG_NS<dim>::leafIndex(object); }, result);
+      return result;
+    }
+
     //! get number of entities of given codim and type
     int size (GeometryType type) const
     {
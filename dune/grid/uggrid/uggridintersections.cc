@@ -5,8 +5,9 @@
 #include <dune/grid/uggrid.hh>
 #include <dune/grid/uggrid/uggridintersections.hh>
 
+#include <algorithm>
+#include <array>
 #include <list>
-#include <set>
 
 namespace Dune {
 
@@ -533,22 +534,28 @@ int UGGridLeafIntersection<GridImp>::getFatherSide(const Face& currentFace) cons
 
     // Get the nodes
     int nNodes = UG_NS<dim>::Corners_Of_Side(currentFace.first,currentFace.second);
-    std::vector<const typename UG_NS<dim>::Node*> n(nNodes);
+    std::array<const typename UG_NS<dim>::Node*, 4> n;
     for (int i=0; i<nNodes; i++)
       n[i] = UG_NS<dim>::Corner(currentFace.first,UG_NS<dim>::Corner_Of_Side(currentFace.first, currentFace.second, i));
 
-    std::set<const typename UG_NS<dim>::Node*> fatherNodes;      // No more than four father nodes
+    // No more than four distinct father nodes, each node contributes at most two
+    std::array<const typename UG_NS<dim>::Node*, 8> fatherNodes;
+    unsigned int nFatherNodes = 0;
+    auto insertFatherNode = [&](const typename UG_NS<dim>::Node* node) {
+      if (std::find(fatherNodes.begin(), fatherNodes.begin()+nFatherNodes, node) == fatherNodes.begin()+nFatherNodes)
+        fatherNodes[nFatherNodes++] = node;
+    };
 
     for (int i=0; i<nNodes; i++) {
 
       switch (UG::D3::ReadCW(n[i], UG::D3::NTYPE_CE)) {
 
       case UG::D3::CORNER_NODE :
-        fatherNodes.insert((const typename UG_NS<dim>::Node*)n[i]->father);
+        insertFatherNode((const typename UG_NS<dim>::Node*)n[i]->father);
         break;
       case UG::D3::MID_NODE :
-        fatherNodes.insert( ((const typename UG_NS<dim>::Edge*)n[i]->father)->links[0].nbnode );
-        fatherNodes.insert( ((const typename UG_NS<dim>::Edge*)n[i]->father)->links[1].nbnode );
+        insertFatherNode( ((const typename UG_NS<dim>::Edge*)n[i]->father)->links[0].nbnode );
+        insertFatherNode( ((const typename UG_NS<dim>::Edge*)n[i]->father)->links[1].nbnode );
         break;
       default :
         break;
@@ -561,20 +568,20 @@ int UGGridLeafIntersection<GridImp>::getFatherSide(const Face& currentFace) cons
        may be the case that a quad face is split into two quads and a triangle.
        In that case the triangle has two CORNER_NODEs and one MID_NODES.  The current
        code does not know how to handle this situation. */
-    if (fatherNodes.size() < 3)
+    if (nFatherNodes < 3)
       DUNE_THROW(NotImplemented, "Anisotropic nonconforming grids are not fully implemented!");
 
     // Find the corresponding side on the father element
     for (int i=0; i<UG_NS<dim>::Sides_Of_Elem(father); i++) {
       unsigned int found = 0;
-      for (const auto& fn : fatherNodes)
+      for (unsigned int j=0; j<nFatherNodes; j++)
         for (int k=0; k<UG_NS<dim>::Corners_Of_Side(father,i); k++)
-          if (fn == UG_NS<dim>::Corner(father,UG_NS<dim>::Corner_Of_Side(father, i, k))) {
+          if (fatherNodes[j] == UG_NS<dim>::Corner(father,UG_NS<dim>::Corner_Of_Side(father, i, k))) {
             found++;
             break;
           }
 
-      if (found==fatherNodes.size())
+      if (found==nFatherNodes)
         return i;
 
     }
@@ -0,0 +1,305 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_UGLBPACKEDTRANSFER_HH
+#define DUNE_UGLBPACKEDTRANSFER_HH
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if HAVE_MPI
+#include <mpi.h>
+#endif
+
+#include <dune/grid/common/gridenums.hh>
+#include <dune/grid/common/mcmgmapper.hh>
+#include <dune/grid/common/rangegenerators.hh>
+
+namespace Dune {
+
+  namespace Impl {
+
+    //! The MPI tags of the messages UGGrid sends itself, in addition to those of DDD
+    enum UGGridMessageTag {
+      ugLBPackedTransferTag = 4711
+    };
+
+  } // namespace Impl
+
+  /** \brief Transfers user data along with a load balancing step with known target ranks
+   *
+   * In contrast to UGLBGatherScatter, the data is not attached to the UG objects.
+   * Instead, the data of all entities going to the same process is packed into a
+   * single contiguous buffer, keyed by the global id of the entity, and sent as a
+   * single message per pair of processes.  After the grid has been transferred, each
+   * process looks up the received data of its leaf entities by their global ids.
+   *
+   * Data is transferred for the interior leaf elements and for the vertices of the
+   * interior leaf elements.  Data arriving for the same entity from several processes
+   * is taken from only one of them.
+   *
+   * \tparam Grid The (UG) grid type
+   */
+  template<class Grid>
+  class UGLBPackedTransfer
+  {
+    enum { dim = Grid::dimension };
+
+    typedef typename Grid::Traits::GlobalIdSet::IdType Id;
+
+    // header in front of the data of each entity, its fields are packed
+    // one after the other such that no padding bytes are sent
+    struct Record
+    {
+      Id id;
+      int codim;
+      std::size_t size;
+
+      static const std::size_t bytes = sizeof(Id) + sizeof(int) + sizeof(std::size_t);
+
+      void write (std::vector<char>& data) const
+      {
+        const std::size_t position = data.size();
+        data.resize(position + bytes);
+        char* p = data.data() + position;
+        std::memcpy(p, &id, sizeof(Id));
+        std::memcpy(p + sizeof(Id), &codim, sizeof(int));
+        std::memcpy(p + sizeof(Id) + sizeof(int), &size, sizeof(std::size_t));
+      }
+
+      void read (const char* p)
+      {
+        std::memcpy(&id, p, sizeof(Id));
+        std::memcpy(&codim, p + sizeof(Id), sizeof(int));
+        std::memcpy(&size, p + sizeof(Id) + sizeof(int), sizeof(std::size_t));
+      }
+    };
+
+    // message buffer writing into and reading from a contiguous byte array
+    template<class DataType>
+    class Buffer
+    {
+    public:
+      explicit Buffer (std::vector<char>& data, std::size_t position = 0)
+        : data_(data), position_(position)
+      {}
+
+      void write (const DataType& x)
+      {
+        const char* bytes = reinterpret_cast<const char*>(&x);
+        data_.insert(data_.end(), bytes, bytes + sizeof(DataType));
+      }
+
+      void read (DataType& x)
+      {
+        std::memcpy(&x, data_.data() + position_, sizeof(DataType));
+        position_ += sizeof(DataType);
+      }
+
+    private:
+      std::vector<char>& data_;
+      std::size_t position_;
+    };
+
+  public:
+    /** \brief Gather the data of all entities and send it to the target processes
+     *
+     * \param grid             The grid before load balancing
+     * \param targetProcessors The target rank of each leaf element, as handed to UGGrid::loadBalance
+     * \param dataHandle       The data handle gathering the data
+     */
+    template<class DataHandle>
+    void gather (const Grid& grid, const std::vector<typename Grid::Rank>& targetProcessors, DataHandle& dataHandle)
+    {
+      typedef typename DataHandle::DataType DataType;
+      typedef typename Grid::LeafGridView GridView;
+
+      const GridView gridView = grid.leafGridView();
+      const int size = grid.comm().size();
+      const bool elementData = dataHandle.contains(dim, 0);
+      const bool vertexData = dataHandle.contains(dim, dim);
+
+      sendBuffers_.resize(size);
+      for (auto& buffer : sendBuffers_)
+        buffer.clear();
+      recvBuffer_.clear();
+      sentBytes_ = 0;
+
+      if (!elementData && !vertexData)
+        return;
+
+      MultipleCodimMultipleGeomTypeMapper<GridView> elementMapper(gridView, mcmgElementLayout());
+      MultipleCodimMultipleGeomTypeMapper<GridView> vertexMapper(gridView, mcmgVertexLayout());
+
+      // pairs of target rank and vertex index, each vertex is sent once to each of its targets
+      std::vector<std::pair<int, int> > vertexTargets;
+
+      for (const auto& element : elements(gridView, Partitions::interior))
+      {
+        const int target = targetProcessors[elementMapper.index(element)];
+
+        if (elementData)
+          pack<DataType>(sendBuffers_[target], grid.globalIdSet().id(element), 0, element, dataHandle);
+
+        if (vertexData)
+          for (unsigned int i=0; i<element.subEntities(dim); i++)
+            vertexTargets.emplace_back(target, vertexMapper.subIndex(element, i, dim));
+      }
+
+      if (vertexData)
+      {
+        std::sort(vertexTargets.begin(), vertexTargets.end());
+        vertexTargets.erase(std::unique(vertexTargets.begin(), vertexTargets.end()), vertexTargets.end());
+
+        // the vertices in index order
+        std::vector<typename GridView::template Codim<dim>::Entity> vertices(gridView.size(dim));
+        for (const auto& vertex : entities(gridView, Codim<dim>()))
+          vertices[vertexMapper.index(vertex)] = vertex;
+
+        for (const auto& vt : vertexTargets)
+        {
+          const auto& vertex = vertices[vt.second];
+          pack<DataType>(sendBuffers_[vt.first], grid.globalIdSet().id(vertex), dim, vertex, dataHandle);
+        }
+      }
+
+      exchange(grid);
+    }
+
+    /** \brief Scatter the received data to the entities of the load balanced grid
+     *
+     * \param grid       The grid after load balancing
+     * \param dataHandle The data handle scattering the data
+     */
+    template<class DataHandle>
+    void scatter (const Grid& grid, DataHandle& dataHandle)
+    {
+      typedef typename DataHandle::DataType DataType;
+
+      // locate the data of each entity in the receive buffer
+      std::unordered_map<Id, std::size_t> elementRecords, vertexRecords;
+      for (std::size_t position = 0; position < recvBuffer_.size(); )
+      {
+        Record record;
+        record.read(recvBuffer_.data() + position);
+        auto& records = (record.codim == 0) ? elementRecords : vertexRecords;
+        records.emplace(record.id, position);
+        position += Record::bytes + record.size * sizeof(DataType);
+      }
+
+      const auto gridView = grid.leafGridView();
+      if (dataHandle.contains(dim, 0))
+        for (const auto& element : elements(gridView))
+          unpack<DataType>(elementRecords, grid.globalIdSet().id(element), element, dataHandle);
+
+      if (dataHandle.contains(dim, dim))
+        for (const auto& vertex : vertices(gridView))
+          unpack<DataType>(vertexRecords, grid.globalIdSet().id(vertex), vertex, dataHandle);
+
+      // release the memory of the transfer
+      std::vector<char>().swap(recvBuffer_);
+      std::vector<std::vector<char> >().swap(sendBuffers_);
+    }
+
+    //! The number of bytes gather() sent to other processes
+    std::size_t sentBytes () const
+    {
+      return sentBytes_;
+    }
+
+  private:
+    template<class DataType, class Entity, class DataHandle>
+    static void pack (std::vector<char>& data, const Id& id, int codim, const Entity& entity, DataHandle& dataHandle)
+    {
+      Record record;
+      record.id = id;
+      record.codim = codim;
+      record.size = dataHandle.size(entity);
+      record.write(data);
+
+      Buffer<DataType> buffer(data);
+      dataHandle.gather(buffer, entity);
+    }
+
+    template<class DataType, class Entity, class DataHandle>
+    void unpack (const std::unordered_map<Id, std::size_t>& records, const Id& id, const Entity& entity, DataHandle& dataHandle)
+    {
+      const auto it = records.find(id);
+      if (it == records.end())
+        return;
+
+      Record record;
+      record.read(recvBuffer_.data() + it->second);
+
+      Buffer<DataType> buffer(recvBuffer_, it->second + Record::bytes);
+      dataHandle.scatter(buffer, entity, record.size);
+    }
+
+    // send each buffer to its target, concatenating all received buffers
+    void exchange (const Grid& grid)
+    {
+      const int rank = grid.comm().rank();
+      const int size = grid.comm().size();
+
+#if HAVE_MPI
+      if (size > 1)
+      {
+        MPI_Comm comm = grid.comm();
+
+        std::vector<unsigned long long> sendSizes(size), recvSizes(size);
+        for (int p=0; p<size; p++)
+        {
+          sendSizes[p] = (p == rank) ? 0 : sendBuffers_[p].size();
+          sentBytes_ += sendSizes[p];
+        }
+        MPI_Alltoall(sendSizes.data(), 1, MPI_UNSIGNED_LONG_LONG,
+                     recvSizes.data(), 1, MPI_UNSIGNED_LONG_LONG, comm);
+
+        std::vector<std::size_t> offsets(size+1, 0);
+        for (int p=0; p<size; p++)
+          offsets[p+1] = offsets[p] + ((p == rank) ? sendBuffers_[p].size() : recvSizes[p]);
+        recvBuffer_.resize(offsets[size]);
+
+        // the messages are split into pieces whose size fits into the int count of MPI,
+        // the pieces from one process arrive in the order they were sent
+        const unsigned long long maxPiece = std::numeric_limits<int>::max();
+        const int tag = Impl::ugLBPackedTransferTag;
+        std::vector<MPI_Request> requests;
+        for (int p=0; p<size; p++)
+          if (p != rank)
+            for (unsigned long long begin = 0; begin < recvSizes[p]; begin += maxPiece)
+            {
+              requests.emplace_back();
+              MPI_Irecv(recvBuffer_.data() + offsets[p] + begin, int(std::min(maxPiece, recvSizes[p] - begin)), MPI_BYTE,
+                        p, tag, comm, &requests.back());
+            }
+        for (int p=0; p<size; p++)
+          if (p != rank)
+            for (unsigned long long begin = 0; begin < sendSizes[p]; begin += maxPiece)
+            {
+              requests.emplace_back();
+              MPI_Isend(sendBuffers_[p].data() + begin, int(std::min(maxPiece, sendSizes[p] - begin)), MPI_BYTE,
+                        p, tag, comm, &requests.back());
+            }
+
+        std::copy(sendBuffers_[rank].begin(), sendBuffers_[rank].end(), recvBuffer_.begin() + offsets[rank]);
+
+        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+        return;
+      }
+#endif
+
+      recvBuffer_.swap(sendBuffers_[rank]);
+    }
+
+    std::vector<std::vector<char> > sendBuffers_;
+    std::vector<char> recvBuffer_;
+    std::size_t sentBytes_ = 0;
+  };
+
+} // namespace Dune
+
+#endif
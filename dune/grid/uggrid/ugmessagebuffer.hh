@@ -4,10 +4,13 @@
 #define UG_MESSAGE_BUFFER_HH
 
 #include <algorithm>
+#include <cstddef>
+#include <vector>
 
 #include <dune/common/parallel/mpihelper.hh>
 
 #include <dune/grid/common/gridenums.hh>
+#include <dune/grid/common/instrumentation.hh>
 
 namespace Dune {
 
@@ -63,6 +66,40 @@ namespace Dune {
       ugData_ += sizeof(ValueType);
     }
 
+    // returns number of bytes required for the UG message buffer,
+    // given the UG objects of all entities that may be communicated
+    template <class GridView>
+    static unsigned ugBufferSize_(const GridView &gv, const std::vector<void*>& ugEntities)
+    {
+      // all entities have the same size, no need to look at more than one
+      if (duneDataHandle_->fixedSize(dim, codim)) {
+        if (ugEntities.empty())
+          return 0;
+        return sizeof(DataType) * duneDataHandle_->size(entity_(ugEntities.front()));
+      }
+
+      // find the maximum size for the current rank
+      int maxSize = 0;
+      for (void* ugEntity : ugEntities)
+        maxSize = std::max(maxSize, (int) duneDataHandle_->size(entity_(ugEntity)));
+
+      // find maximum size for all ranks
+      maxSize = gv.comm().max(maxSize);
+      if (!maxSize)
+        return 0;
+
+      // add the size of an unsigned integer to the actual
+      // buffer size. (we somewhere have to store the actual
+      // number of objects for each entity.)
+      return sizeof(unsigned) + sizeof(DataType)*maxSize;
+    }
+
+    // construct a DUNE entity from a UG object
+    static Entity entity_(void* ugEntity)
+    {
+      return Entity(EntityImp(static_cast<typename Dune::UG_NS<dim>::template Entity<codim>::T*>(ugEntity), grid_));
+    }
+
     // called by DDD_IFOneway to serialize the data structure to
     // be send
     static int ugGather_(
@@ -71,6 +108,10 @@ namespace Dune {
 #endif
       typename UG_NS<dim>::DDD_OBJ obj, void* data)
     {
+#if DUNE_GRID_INSTRUMENTATION
+      ++gathered_;
+#endif
+
       // cast the DDD object to a UG entity pointer
       auto ugEP = reinterpret_cast<typename Dune::UG_NS<dim>::template Entity<codim>::T*>(obj);
 
@@ -127,6 +168,10 @@ namespace Dune {
     static const GridType* grid_;
     static DataHandle *duneDataHandle_;
     static int level;
+#if DUNE_GRID_INSTRUMENTATION
+    // number of objects DDD sent in the current communication
+    static std::size_t gathered_;
+#endif
     char *ugData_;
   };
 
@@ -144,35 +189,6 @@ namespace Dune {
     UGMessageBuffer(void *ugData)
       : Base(ugData)
     {}
-
-    // returns number of bytes required for the UG message buffer
-    template <class GridView>
-    static unsigned ugBufferSize_(const GridView &gv)
-    {
-      if (Base::duneDataHandle_->fixedSize(dim, codim)) {
-        return sizeof(DataType)
-               * Base::duneDataHandle_->size(*gv.template begin<codim,InteriorBorder_Partition>());
-      }
-
-      // iterate over all entities, find the maximum size for
-      // the current rank
-      int maxSize = 0;
-      for (const auto& entity : entities(gv, Codim<codim>(), Dune::Partitions::all))
-      {
-        maxSize = std::max((int) maxSize,
-                           (int) Base::duneDataHandle_->size(entity));
-      }
-
-      // find maximum size for all ranks
-      maxSize = gv.comm().max(maxSize);
-      if (!maxSize)
-        return 0;
-
-      // add the size of an unsigned integer to the actual
-      // buffer size. (we somewhere have to store the actual
-      // number of objects for each entity.)
-      return sizeof(unsigned) + sizeof(DataType)*maxSize;
-    }
   };
 
   template <class DataHandle, int GridDim, int codim>
@@ -188,42 +204,6 @@ namespace Dune {
     UGEdgeAndFaceMessageBuffer(void *ugData)
       : Base(ugData)
     {}
-
-    // returns number of bytes required for the UG message buffer
-    template <class GridView>
-    static unsigned ugBufferSize_(const GridView &gv)
-    {
-      if (Base::duneDataHandle_->fixedSize(dim, codim)) {
-        auto element = gv.template begin<0, InteriorBorder_Partition>();
-        return sizeof(DataType)
-               * Base::duneDataHandle_->size(element->template subEntity<codim>(0));
-      }
-
-      // iterate over all entities, find the maximum size for
-      // the current rank
-      int maxSize = 0;
-      for (const auto& element : elements(gv, Dune::Partitions::all))
-      {
-        int numberOfSubentities = element.subEntities(codim);
-        for (int k = 0; k < numberOfSubentities; k++)
-        {
-          const auto subEntity = element.template subEntity<codim>(k);
-
-          maxSize = std::max((int) maxSize,
-                             (int) Base::duneDataHandle_->size(subEntity));
-        }
-      }
-
-      // find maximum size for all ranks
-      maxSize = gv.comm().max(maxSize);
-      if (!maxSize)
-        return 0;
-
-      // add the size of an unsigned integer to the actual
-      // buffer size. (we somewhere have to store the actual
-      // number of objects for each entity.)
-      return sizeof(unsigned) + sizeof(DataType)*maxSize;
-    }
   };
 
   template <class DataHandle>
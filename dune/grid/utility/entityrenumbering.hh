@@ -0,0 +1,314 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_UTILITY_ENTITYRENUMBERING_HH
+#define DUNE_GRID_UTILITY_ENTITYRENUMBERING_HH
+
+/** \file
+ *  \brief Renumber the elements and vertices of a grid view for better memory locality
+ *
+ *  Index sets usually number the entities in the order of the traversal,
+ *  which for adaptively refined unstructured grids follows the history of
+ *  the refinement.  Data stored by such an index is scattered in memory:
+ *  neighboring elements and the vertices of an element are far apart.  The
+ *  EntityRenumbering numbers the elements and the vertices along a Hilbert
+ *  curve or by the reverse Cuthill-McKee algorithm instead, such that
+ *  entities close to each other in the grid get close indices.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+
+#include <dune/grid/common/mcmgmapper.hh>
+#include <dune/grid/common/rangegenerators.hh>
+#include <dune/grid/utility/spacefillingcurvepartitioner.hh>
+
+namespace Dune
+{
+
+  /** \brief Consecutive indices for the elements and the vertices of a grid view, ordered for memory locality
+   *
+   *  The renumbering can be used like a MultipleCodimMultipleGeomTypeMapper for
+   *  the elements or for the vertices: index() and subIndex() return indices in
+   *  the range [0, size(codim)).  The elements can be visited in the order of
+   *  their new indices through elementSeeds().
+   *
+   *  The renumbering has to be recomputed with update() after each modification
+   *  of the grid.
+   *
+   *  \tparam GV The grid view
+   */
+  template<class GV>
+  class EntityRenumbering
+  {
+    typedef MultipleCodimMultipleGeomTypeMapper<GV> Mapper;
+
+  public:
+    typedef GV GridView;
+
+    enum { dimension = GridView::dimension };
+
+    //! The available orderings
+    enum Ordering {
+      //! order the element centers and the vertices along a Hilbert curve
+      hilbert,
+      //! order the elements by their face neighbors and the vertices by their elements with reverse Cuthill-McKee
+      reverseCuthillMcKee
+    };
+
+    typedef std::size_t Index;
+
+    typedef typename GridView::template Codim<0>::Entity Element;
+    typedef typename Element::EntitySeed ElementSeed;
+
+    /** \brief Compute the renumbering
+     *
+     *  \param gridView The grid view, its elements and vertices are renumbered
+     *  \param ordering The ordering of the new indices
+     */
+    explicit EntityRenumbering (const GridView& gridView, Ordering ordering = hilbert)
+      : gridView_(gridView),
+        ordering_(ordering),
+        elementMapper_(gridView, mcmgElementLayout()),
+        vertexMapper_(gridView, mcmgVertexLayout())
+    {
+      update();
+    }
+
+    //! Recompute the renumbering after a modification of the grid
+    void update ()
+    {
+      elementMapper_.update();
+      vertexMapper_.update();
+
+      std::vector<ElementSeed> seeds(elementMapper_.size());
+      for (const auto& element : elements(gridView_))
+        seeds[elementMapper_.index(element)] = element.seed();
+
+      std::array<std::vector<Index>, 2> order;
+      if (ordering_ == hilbert)
+        hilbertOrder(order);
+      else
+        reverseCuthillMcKeeOrder(order);
+
+      for (int c = 0; c < 2; ++c)
+      {
+        newIndex_[c].resize(order[c].size());
+        for (Index k = 0; k < order[c].size(); ++k)
+          newIndex_[c][order[c][k]] = k;
+      }
+
+      elementSeeds_.resize(seeds.size());
+      for (Index k = 0; k < seeds.size(); ++k)
+        elementSeeds_[k] = seeds[order[0][k]];
+    }
+
+    //! The new index of an element or a vertex
+    template<class Entity>
+    Index index (const Entity& entity) const
+    {
+      static_assert(Entity::codimension == 0 || Entity::codimension == dimension,
+                    "Only elements and vertices are renumbered");
+      const int c = (Entity::codimension == 0) ? 0 : 1;
+      return newIndex_[c][mapper(c).index(entity)];
+    }
+
+    //! The new index of a subentity of an element, codim has to be 0 or the dimension
+    Index subIndex (const Element& element, int i, unsigned int codim) const
+    {
+      assert(contains(codim));
+      const int c = (codim == 0) ? 0 : 1;
+      return newIndex_[c][mapper(c).subIndex(element, i, codim)];
+    }
+
+    //! The number of elements or vertices
+    Index size (int codim) const
+    {
+      assert(contains(codim));
+      return newIndex_[codim == 0 ? 0 : 1].size();
+    }
+
+    //! Whether entities of the codimension are renumbered
+    bool contains (int codim) const
+    {
+      return (codim == 0) || (codim == dimension);
+    }
+
+    //! The seeds of all elements, ordered by their new index
+    const std::vector<ElementSeed>& elementSeeds () const
+    {
+      return elementSeeds_;
+    }
+
+    const GridView& gridView () const
+    {
+      return gridView_;
+    }
+
+  private:
+    typedef SpaceFillingCurvePartitioner<GridView> Curve;
+    typedef FieldVector<typename GridView::ctype, GridView::dimensionworld> Coordinate;
+
+    const Mapper& mapper (int c) const
+    {
+      return (c == 0) ? elementMapper_ : vertexMapper_;
+    }
+
+    // the element centers and the vertices sorted along the Hilbert curve
+    void hilbertOrder (std::array<std::vector<Index>, 2>& order) const
+    {
+      std::array<std::vector<Coordinate>, 2> points;
+      points[0].resize(elementMapper_.size());
+      points[1].resize(vertexMapper_.size());
+      for (const auto& element : elements(gridView_))
+        points[0][elementMapper_.index(element)] = element.geometry().center();
+      for (const auto& vertex : vertices(gridView_))
+        points[1][vertexMapper_.index(vertex)] = vertex.geometry().corner(0);
+
+      for (int c = 0; c < 2; ++c)
+      {
+        // the bounding box of all points of this process
+        Coordinate lower(std::numeric_limits<typename GridView::ctype>::max());
+        Coordinate upper(std::numeric_limits<typename GridView::ctype>::lowest());
+        for (const Coordinate& x : points[c])
+          for (int i = 0; i < GridView::dimensionworld; ++i)
+          {
+            lower[i] = std::min(lower[i], x[i]);
+            upper[i] = std::max(upper[i], x[i]);
+          }
+
+        std::vector<std::pair<typename Curve::Key, Index> > keys(points[c].size());
+        for (Index k = 0; k < points[c].size(); ++k)
+          keys[k] = std::make_pair(Curve::hilbertKey(Curve::cell(points[c][k], lower, upper)), k);
+        std::sort(keys.begin(), keys.end());
+
+        order[c].resize(keys.size());
+        for (Index k = 0; k < keys.size(); ++k)
+          order[c][k] = keys[k].second;
+      }
+    }
+
+    // the elements and the vertices ordered by reverse Cuthill-McKee on their adjacency graphs
+    void reverseCuthillMcKeeOrder (std::array<std::vector<Index>, 2>& order) const
+    {
+      // elements are adjacent if they share a face, vertices if they share an element
+      std::array<std::vector<std::pair<Index, Index> >, 2> edges;
+      for (const auto& element : elements(gridView_))
+      {
+        const Index index = elementMapper_.index(element);
+        for (const auto& intersection : intersections(gridView_, element))
+          if (intersection.neighbor())
+            edges[0].emplace_back(index, elementMapper_.index(intersection.outside()));
+
+        const unsigned int corners = element.subEntities(dimension);
+        for (unsigned int i = 0; i < corners; ++i)
+          for (unsigned int j = 0; j < corners; ++j)
+            if (i != j)
+              edges[1].emplace_back(vertexMapper_.subIndex(element, i, dimension),
+                                    vertexMapper_.subIndex(element, j, dimension));
+      }
+
+      order[0] = reverseCuthillMcKee(elementMapper_.size(), edges[0]);
+      order[1] = reverseCuthillMcKee(vertexMapper_.size(), edges[1]);
+    }
+
+    // the reverse Cuthill-McKee order of a graph, each connected component starts at a pseudo-peripheral node
+    static std::vector<Index> reverseCuthillMcKee (Index n, std::vector<std::pair<Index, Index> >& edges)
+    {
+      // compressed adjacency lists
+      std::sort(edges.begin(), edges.end());
+      edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+      std::vector<Index> offsets(n+1, 0);
+      for (const auto& edge : edges)
+        ++offsets[edge.first+1];
+      std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+      auto degree = [&offsets] (Index v) { return offsets[v+1] - offsets[v]; };
+
+      std::vector<Index> order;
+      order.reserve(n);
+
+      // breadth-first search from root over the nodes not done yet, neighbors by increasing degree;
+      // returns the position of the last level in queue
+      const Index done = std::numeric_limits<Index>::max();
+      std::vector<Index> visited(n, 0);
+      Index stamp = 0;
+      std::vector<Index> neighbors;
+      auto search = [&] (Index root, std::vector<Index>& queue) {
+        ++stamp;
+        const Index begin = queue.size();
+        queue.push_back(root);
+        visited[root] = stamp;
+        Index levelBegin = begin, levelEnd = queue.size();
+        Index lastLevel = begin;
+        while (levelBegin < levelEnd)
+        {
+          lastLevel = levelBegin;
+          for (Index q = levelBegin; q < levelEnd; ++q)
+          {
+            neighbors.clear();
+            for (Index e = offsets[queue[q]]; e < offsets[queue[q]+1]; ++e)
+            {
+              const Index w = edges[e].second;
+              if (visited[w] != stamp && visited[w] != done)
+              {
+                visited[w] = stamp;
+                neighbors.push_back(w);
+              }
+            }
+            std::sort(neighbors.begin(), neighbors.end(), [&] (Index a, Index b) {
+                return degree(a) < degree(b) || (degree(a) == degree(b) && a < b);
+              });
+            queue.insert(queue.end(), neighbors.begin(), neighbors.end());
+          }
+          levelBegin = levelEnd;
+          levelEnd = queue.size();
+        }
+        return lastLevel;
+      };
+
+      // start candidates by increasing degree
+      std::vector<Index> candidates(n);
+      std::iota(candidates.begin(), candidates.end(), Index(0));
+      std::stable_sort(candidates.begin(), candidates.end(), [&] (Index a, Index b) { return degree(a) < degree(b); });
+
+      std::vector<Index> component;
+      for (Index start : candidates)
+      {
+        if (visited[start] == done)
+          continue;
+
+        // a node of minimal degree in the last level of a search from start is pseudo-peripheral
+        component.clear();
+        const Index lastLevel = search(start, component);
+        const Index root = *std::min_element(component.begin() + lastLevel, component.end(),
+                                             [&] (Index a, Index b) { return degree(a) < degree(b); });
+
+        const Index begin = order.size();
+        search(root, order);
+        for (Index k = begin; k < order.size(); ++k)
+          visited[order[k]] = done;
+      }
+
+      std::reverse(order.begin(), order.end());
+      return order;
+    }
+
+    GridView gridView_;
+    Ordering ordering_;
+    Mapper elementMapper_;
+    Mapper vertexMapper_;
+    std::array<std::vector<Index>, 2> newIndex_;
+    std::vector<ElementSeed> elementSeeds_;
+  };
+
+} // namespace Dune
+
+#endif // DUNE_GRID_UTILITY_ENTITYRENUMBERING_HH
@@ -0,0 +1,75 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_UTILITY_ENTITYSEEDS_HH
+#define DUNE_GRID_UTILITY_ENTITYSEEDS_HH
+
+/** \file
+ *  \brief Collect the entity seeds of a grid view in a flat array and turn
+ *  arrays of seeds back into entities
+ *
+ *  Thread-parallel and out-of-order algorithms can store seeds in flat arrays
+ *  or work queues and obtain the entities with Grid::entity() without any
+ *  iterator state.  The seeds of YaspGrid, UGGrid and OneDGrid are trivially
+ *  copyable and small: one pointer for UGGrid and OneDGrid, and dim+1 integers
+ *  for YaspGrid.  Their Grid::entity() does not access shared mutable state,
+ *  so it may be called from several threads at once.
+ */
+
+#include <cstddef>
+#include <vector>
+
+#include <dune/geometry/dimension.hh>
+
+#include <dune/grid/common/rangegenerators.hh>
+
+namespace Dune
+{
+
+  /** \brief The seeds of all entities of a codimension of a grid view, in the order of the traversal
+   *
+   *  \tparam codim The codimension of the entities
+   *  \param gridView The grid view
+   */
+  template<int codim, class GridView>
+  std::vector<typename GridView::template Codim<codim>::Entity::EntitySeed>
+  entitySeeds (const GridView& gridView)
+  {
+    std::vector<typename GridView::template Codim<codim>::Entity::EntitySeed> seeds;
+    seeds.reserve(gridView.size(codim));
+    for (const auto& entity : entities(gridView, Codim<codim>()))
+      seeds.push_back(entity.seed());
+    return seeds;
+  }
+
+  /** \brief Obtain the entities of an array of seeds from the grid
+   *
+   *  \param grid  The grid the seeds were taken from
+   *  \param seeds The seeds, all have to be valid
+   *  \param[out] result The entities, result[i] belongs to seeds[i]
+   */
+  template<class Grid, class Seed, class Entity>
+  void entitiesFromSeeds (const Grid& grid, const std::vector<Seed>& seeds, std::vector<Entity>& result)
+  {
+    result.clear();
+    result.reserve(seeds.size());
+    for (const Seed& seed : seeds)
+      result.push_back(grid.entity(seed));
+  }
+
+  /** \brief Obtain the entities of an array of seeds from the grid
+   *
+   *  \param grid  The grid the seeds were taken from
+   *  \param seeds The seeds, all have to be valid
+   */
+  template<class Grid, class Seed>
+  std::vector<typename Grid::template Codim<Seed::codimension>::Entity>
+  entitiesFromSeeds (const Grid& grid, const std::vector<Seed>& seeds)
+  {
+    std::vector<typename Grid::template Codim<Seed::codimension>::Entity> result;
+    entitiesFromSeeds(grid, seeds, result);
+    return result;
+  }
+
+} // namespace Dune
+
+#endif // DUNE_GRID_UTILITY_ENTITYSEEDS_HH
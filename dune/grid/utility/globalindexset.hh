@@ -185,17 +185,20 @@ namespace Dune
 
         // assign own rank to entities that I might have
         for (auto it = gridview.template begin<0>(); it!=gridview.template end<0>(); ++it)
-          for (unsigned int i=0; i<it->subEntities(codim); i++)
+        {
+          const auto subIndices = gridview.indexSet().subIndices(*it,codim);
+          for (unsigned int i=0; i<subIndices.size(); i++)
           {
             // Evil hack: I need to call subEntity, which needs the entity codimension as a static parameter.
             // However, we only have it as a run-time parameter.
             PartitionType subPartitionType = SubPartitionTypeProvider<typename GridView::template Codim<0>::Entity, GridView::dimension>::get(*it,codim,i);
 
-            assignment_[gridview.indexSet().subIndex(*it,i,codim)]
+            assignment_[subIndices[i]]
               = ( subPartitionType==Dune::InteriorEntity or subPartitionType==Dune::BorderEntity )
               ? gridview.comm().rank()  // set to own rank
               : - 1;   // it is a ghost entity, I will not possibly own it.
           }
+        }
 
         /** exchange entity index through communication */
         MinimumExchange<IndexSet,std::vector<Index> > dh(gridview.indexSet(),assignment_,codim);
@@ -409,17 +412,18 @@ namespace Dune
 
       for(Iterator iter = gridview_.template begin<0>();iter!=gridview_.template end<0>(); ++iter)
       {
-        for (size_t i=0; i<iter->subEntities(codim_); i++)
+        const auto subIndices = gridview_.indexSet().subIndices(*iter,codim_);
+        for (size_t i=0; i<subIndices.size(); i++)
         {
-          IdType id=globalIdSet.subId(*iter,i,codim_);
-
-          Index idx = gridview_.indexSet().subIndex(*iter,i,codim_);
+          Index idx = subIndices[i];
 
           if (!firstTime[idx] )
             continue;
 
           firstTime[idx] = false;
 
+          IdType id=globalIdSet.subId(*iter,i,codim_);
+
           if (uniqueEntityPartition->owner(idx) == rank)  /** if the entity is owned by the process, go ahead with computing the global index */
           {
             const Index gindex = myoffset + globalcontrib;    /** compute global index */
@@ -0,0 +1,212 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_UTILITY_INTERSECTIONCACHE_HH
+#define DUNE_GRID_UTILITY_INTERSECTIONCACHE_HH
+
+/** \file
+ *  \brief Flat arrays of the intersections of all elements of a grid view
+ *
+ *  Finite volume and discontinuous Galerkin schemes iterate over all
+ *  intersections many times per time step.  On unstructured grids like UGGrid
+ *  and AlbertaGrid, each intersection iteration looks up the neighbors and
+ *  recomputes the face geometry and the normals.  The IntersectionCache does
+ *  this once and stores the result in one contiguous array, ordered like the
+ *  element traversal.  It has to be rebuilt with update() after each
+ *  modification of the grid.
+ */
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+#include <dune/common/iteratorrange.hh>
+
+#include <dune/geometry/multilineargeometry.hh>
+#include <dune/geometry/type.hh>
+
+#include <dune/grid/common/mcmgmapper.hh>
+#include <dune/grid/common/rangegenerators.hh>
+
+namespace Dune
+{
+
+  /** \brief The intersections of all elements of a grid view, computed once and stored in a flat array
+   *
+   *  For each intersection, the cache stores the seed of the outside element,
+   *  the local face numbers, the unit outer normal in the center, the face
+   *  geometry and its volume.  The intersections of an element are obtained
+   *  with intersections() in the order of the intersection iterator of the
+   *  grid view.  The outside element can be obtained from its seed with
+   *  outside().
+   *
+   *  \tparam GV The grid view
+   */
+  template<class GV>
+  class IntersectionCache
+  {
+  public:
+    typedef GV GridView;
+    typedef typename GridView::ctype ctype;
+
+    static const int dimension = GridView::dimension;
+    static const int dimensionworld = GridView::dimensionworld;
+
+    typedef typename GridView::template Codim<0>::Entity Element;
+    typedef typename Element::EntitySeed ElementSeed;
+    typedef FieldVector<ctype, dimensionworld> GlobalCoordinate;
+
+    //! The corners of a face are stored in place, there are at most 2^(dim-1) of them
+    struct GeometryTraits
+      : public MultiLinearGeometryTraits<ctype>
+    {
+      template<int mydim, int cdim>
+      struct CornerStorage
+      {
+        typedef std::array<FieldVector<ctype, cdim>, (1 << mydim)> Type;
+      };
+    };
+
+    //! The geometry of a cached face
+    typedef MultiLinearGeometry<ctype, dimension-1, dimensionworld, GeometryTraits> Geometry;
+
+    //! The cached data of one intersection, the methods correspond to those of Dune::Intersection
+    class Intersection
+    {
+      friend class IntersectionCache;
+
+      typedef typename GeometryTraits::template CornerStorage<dimension-1, dimensionworld>::Type Corners;
+
+      Intersection (GeometryType type, const Corners& corners)
+        : geometry_(type, corners)
+      {}
+
+    public:
+      //! Is the intersection on the domain boundary?
+      bool boundary () const { return boundary_; }
+
+      //! Is there an outside element?
+      bool neighbor () const { return neighbor_; }
+
+      //! Do inside and outside element share the whole face?
+      bool conforming () const { return conforming_; }
+
+      //! The boundary segment index, only valid if boundary() is true
+      std::size_t boundarySegmentIndex () const { return boundarySegmentIndex_; }
+
+      //! Local number of the face in the inside element
+      int indexInInside () const { return indexInInside_; }
+
+      //! Local number of the face in the outside element, only valid if neighbor() is true
+      int indexInOutside () const { return indexInOutside_; }
+
+      //! Seed of the outside element, only valid if neighbor() is true
+      const ElementSeed& outsideSeed () const { return outside_; }
+
+      //! Geometry of the intersection in world coordinates
+      const Geometry& geometry () const { return geometry_; }
+
+      //! Volume of the intersection
+      ctype volume () const { return volume_; }
+
+      //! The unit outer normal in the center of the intersection
+      const GlobalCoordinate& centerUnitOuterNormal () const { return centerUnitOuterNormal_; }
+
+    private:
+      Geometry geometry_;
+      GlobalCoordinate centerUnitOuterNormal_;
+      ctype volume_;
+      ElementSeed outside_;
+      std::size_t boundarySegmentIndex_;
+      int indexInInside_;
+      int indexInOutside_;
+      bool boundary_;
+      bool neighbor_;
+      bool conforming_;
+    };
+
+    typedef typename std::vector<Intersection>::const_iterator Iterator;
+
+    //! Compute the intersections of all elements of the grid view
+    explicit IntersectionCache (const GridView& gridView)
+      : gridView_(gridView),
+        mapper_(gridView, mcmgElementLayout())
+    {
+      update();
+    }
+
+    /** \brief Recompute the intersections
+     *
+     *  This has to be called after each modification of the grid.
+     */
+    void update ()
+    {
+      mapper_.update();
+
+      // the intersections are stored in traversal order, each element knows its range
+      ranges_.assign(mapper_.size(), std::make_pair(std::size_t(0), std::size_t(0)));
+      intersections_.clear();
+      for (const auto& element : elements(gridView_))
+      {
+        auto& range = ranges_[mapper_.index(element)];
+        range.first = intersections_.size();
+        for (const auto& is : Dune::intersections(gridView_, element))
+        {
+          const auto geometry = is.geometry();
+          typename Intersection::Corners corners;
+          for (int i = 0; i < geometry.corners(); ++i)
+            corners[i] = geometry.corner(i);
+
+          intersections_.push_back(Intersection(geometry.type(), corners));
+          Intersection& c = intersections_.back();
+          c.centerUnitOuterNormal_ = is.centerUnitOuterNormal();
+          c.volume_ = geometry.volume();
+          c.boundary_ = is.boundary();
+          c.neighbor_ = is.neighbor();
+          c.conforming_ = is.conforming();
+          c.boundarySegmentIndex_ = c.boundary_ ? is.boundarySegmentIndex() : 0;
+          c.indexInInside_ = is.indexInInside();
+          c.indexInOutside_ = c.neighbor_ ? is.indexInOutside() : -1;
+          if (c.neighbor_)
+            c.outside_ = is.outside().seed();
+        }
+        range.second = intersections_.size();
+      }
+    }
+
+    //! The cached intersections of an element
+    IteratorRange<Iterator> intersections (const Element& element) const
+    {
+      const auto& range = ranges_[mapper_.index(element)];
+      return IteratorRange<Iterator>(intersections_.begin() + range.first,
+                                     intersections_.begin() + range.second);
+    }
+
+    //! The outside element of an intersection, it must have a neighbor
+    Element outside (const Intersection& intersection) const
+    {
+      return gridView_.grid().entity(intersection.outsideSeed());
+    }
+
+    //! The number of cached intersections
+    std::size_t size () const
+    {
+      return intersections_.size();
+    }
+
+    const GridView& gridView () const
+    {
+      return gridView_;
+    }
+
+  private:
+    GridView gridView_;
+    MultipleCodimMultipleGeomTypeMapper<GridView> mapper_;
+    std::vector<std::pair<std::size_t, std::size_t> > ranges_;
+    std::vector<Intersection> intersections_;
+  };
+
+} // namespace Dune
+
+#endif // DUNE_GRID_UTILITY_INTERSECTIONCACHE_HH
@@ -0,0 +1,224 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_UTILITY_SPACEFILLINGCURVEPARTITIONER_HH
+#define DUNE_GRID_UTILITY_SPACEFILLINGCURVEPARTITIONER_HH
+
+/** \file
+ *  \brief Compute a (re-)partitioning of a Dune grid along a space-filling curve
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+
+#include <dune/grid/common/mcmgmapper.hh>
+#include <dune/grid/common/rangegenerators.hh>
+
+namespace Dune
+{
+
+  /** \brief Compute a partitioning of a Dune grid by cutting a space-filling curve into pieces of equal weight
+   *
+   * The interior elements of all processes are ordered along a Hilbert or Morton
+   * curve through their centers.  This order is cut into as many consecutive
+   * pieces as there are processes, such that the total weight of each piece is
+   * (up to the weight of a single element) the same.  The cut positions are found
+   * by a distributed bisection on the curve keys, which needs a fixed number of
+   * global reductions and no data other than the element centers.  The result only
+   * depends on the geometry of the grid, hence repeated calls on a slightly changed
+   * grid move only few elements.
+   *
+   * The result can be passed directly to UGGrid::loadBalance(targetProcessors, fromLevel).
+   */
+  template<class GridView>
+  struct SpaceFillingCurvePartitioner
+  {
+    enum { dimension = GridView::dimensionworld };
+
+    //! the space-filling curves available
+    enum Curve { hilbert, morton };
+
+    typedef std::uint64_t Key;
+
+    /** \brief Partition the grid with equal weights for all elements
+     *
+     * \param gv    The grid view to be partitioned
+     * \param curve The space-filling curve to use
+     *
+     * \return std::vector with one uint per All_Partition element.  For each Interior_Partition element,
+     *    the entry is the number of the partition the element is assigned to.
+     */
+    static std::vector<unsigned> partition (const GridView& gv, Curve curve = hilbert)
+    {
+      return partition(gv, [](const typename GridView::template Codim<0>::Entity&) { return 1.0; }, curve);
+    }
+
+    /** \brief Partition the grid with given element weights
+     *
+     * \param gv     The grid view to be partitioned
+     * \param weight Function returning the non-negative weight of an interior element;
+     *               the total weight has to be positive
+     * \param curve  The space-filling curve to use
+     *
+     * \return std::vector with one uint per All_Partition element.  For each Interior_Partition element,
+     *    the entry is the number of the partition the element is assigned to.
+     */
+    template<class Weight>
+    static std::vector<unsigned> partition (const GridView& gv, const Weight& weight, Curve curve = hilbert)
+    {
+      typedef FieldVector<typename GridView::ctype, dimension> Coordinate;
+      const auto& comm = gv.comm();
+
+      // global bounding box of the element centers
+      std::array<double, 2*dimension> box;
+      std::fill(box.begin(), box.end(), -std::numeric_limits<double>::max());
+      std::vector<Coordinate> centers;
+      std::vector<double> weights;
+      for (const auto& element : elements(gv, Partitions::interior))
+      {
+        const Coordinate center = element.geometry().center();
+        for (int i=0; i<dimension; i++)
+        {
+          box[i] = std::max(box[i], -double(center[i]));
+          box[dimension+i] = std::max(box[dimension+i], double(center[i]));
+        }
+        centers.push_back(center);
+        weights.push_back(weight(element));
+      }
+      comm.max(box.data(), box.size());
+      Coordinate lower, upper;
+      for (int i=0; i<dimension; i++)
+      {
+        lower[i] = -box[i];
+        upper[i] = box[dimension+i];
+      }
+
+      // curve keys of the elements, sorted together with their weights
+      std::vector<std::pair<Key, double> > keyed(centers.size());
+      for (std::size_t k=0; k<centers.size(); k++)
+      {
+        const std::array<std::uint32_t, dimension> c = cell(centers[k], lower, upper);
+        keyed[k] = std::make_pair(curve == hilbert ? hilbertKey(c) : mortonKey(c), weights[k]);
+      }
+
+      std::vector<std::pair<Key, double> > sorted(keyed);
+      std::sort(sorted.begin(), sorted.end());
+      std::vector<Key> keys(sorted.size());
+      std::vector<double> prefix(sorted.size()+1, 0.0);
+      for (std::size_t k=0; k<sorted.size(); k++)
+      {
+        keys[k] = sorted[k].first;
+        prefix[k+1] = prefix[k] + sorted[k].second;
+      }
+
+      double total = prefix.back();
+      total = comm.sum(total);
+
+      // splitter k is the smallest key such that the weight of all smaller keys reaches k/P of the total
+      const int P = comm.size();
+      std::vector<Key> lower(P-1, 0), upper(P-1, Key(1) << (dimension*bits));
+      std::vector<double> below(P-1);
+      for (int it=0; it<dimension*bits; it++)
+      {
+        for (int k=0; k<P-1; k++)
+        {
+          const Key mid = lower[k] + (upper[k]-lower[k])/2;
+          below[k] = prefix[std::lower_bound(keys.begin(), keys.end(), mid) - keys.begin()];
+        }
+        comm.sum(below.data(), below.size());
+        for (int k=0; k<P-1; k++)
+        {
+          const Key mid = lower[k] + (upper[k]-lower[k])/2;
+          if (below[k] >= (k+1)*total/P)
+            upper[k] = mid;
+          else
+            lower[k] = mid;
+        }
+      }
+
+      // assign each interior element to the piece its key falls into
+      typedef MultipleCodimMultipleGeomTypeMapper<GridView> ElementMapper;
+      ElementMapper elementMapper(gv, mcmgElementLayout());
+
+      std::vector<unsigned> part(gv.size(0), 0);
+      std::size_t k = 0;
+      for (const auto& element : elements(gv, Partitions::interior))
+        part[elementMapper.index(element)] =
+          std::upper_bound(upper.begin(), upper.end(), keyed[k++].first) - upper.begin();
+
+      return part;
+    }
+
+    //! bits per direction of the curve keys
+    static const int bits = (dimension == 1) ? 31 : 63/dimension;
+
+    //! The cell of a point, if the bounding box [lower, upper] is divided into 2^bits cells per direction
+    template<class Point>
+    static std::array<std::uint32_t, dimension> cell (const Point& x, const Point& lower, const Point& upper)
+    {
+      std::array<std::uint32_t, dimension> c;
+      for (int i=0; i<dimension; i++)
+      {
+        const double extent = upper[i] - lower[i];
+        const double y = (extent > 0) ? (x[i] - lower[i]) / extent : 0.0;
+        c[i] = std::uint32_t(std::min<double>(y * (1u << bits), (1u << bits) - 1));
+      }
+      return c;
+    }
+
+    /** \brief Key of a cell along the Hilbert curve
+     *
+     * Uses the algorithm of J. Skilling, Programming the Hilbert curve,
+     * AIP Conf. Proc. 707 (2004), which works in any dimension.
+     */
+    static Key hilbertKey (std::array<std::uint32_t, dimension> x)
+    {
+      const std::uint32_t m = 1u << (bits-1);
+
+      // inverse undo excess work
+      for (std::uint32_t q = m; q > 1; q >>= 1)
+      {
+        const std::uint32_t p = q - 1;
+        for (int i=0; i<dimension; i++)
+          if (x[i] & q)
+            x[0] ^= p;
+          else
+          {
+            const std::uint32_t t = (x[0] ^ x[i]) & p;
+            x[0] ^= t;
+            x[i] ^= t;
+          }
+      }
+
+      // Gray encode
+      for (int i=1; i<dimension; i++)
+        x[i] ^= x[i-1];
+      std::uint32_t t = 0;
+      for (std::uint32_t q = m; q > 1; q >>= 1)
+        if (x[dimension-1] & q)
+          t ^= q - 1;
+      for (int i=0; i<dimension; i++)
+        x[i] ^= t;
+
+      return mortonKey(x);
+    }
+
+    //! Key of a cell along the Morton (Z-order) curve, i.e., the interleaved bits of its coordinates
+    static Key mortonKey (const std::array<std::uint32_t, dimension>& x)
+    {
+      Key key = 0;
+      for (int b=bits-1; b>=0; b--)
+        for (int i=0; i<dimension; i++)
+          key = (key << 1) | ((x[i] >> b) & 1u);
+      return key;
+    }
+  };
+
+}  // namespace Dune
+
+#endif // DUNE_GRID_UTILITY_SPACEFILLINGCURVEPARTITIONER_HH
@@ -0,0 +1,210 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_UTILITY_STRUCTUREDCONNECTIVITY_HH
+#define DUNE_GRID_UTILITY_STRUCTUREDCONNECTIVITY_HH
+
+/** \file
+ *  \brief Generate the vertex coordinates and the element corners of
+ *  structured cube and simplex grids as flat arrays.
+ *  This is used by various factory classes.
+ *
+ *  The vertices are numbered lexicographically, the first direction running
+ *  fastest.  The elements are ordered like the cubes they belong to, which are
+ *  numbered in the same way; the simplices of each cube are ordered by the
+ *  permutations of the coordinate directions.  The arrays can be handed to
+ *  GridFactoryInterface::insertVertices and GridFactoryInterface::insertElements.
+ *
+ *  All functions can restrict the grid to a slab of element layers in the last
+ *  coordinate direction, such that each process of a parallel run can generate
+ *  only its own part, see structuredSlab().  The vertices of a slab are numbered
+ *  starting from zero at its lowest vertex layer.  The rows of the grid are
+ *  generated in parallel if OpenMP is enabled.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+
+namespace Dune
+{
+ namespace FactoryUtilities
+ {
+
+  /** \brief The element layers [first, last) of the given process
+   *
+   *  \param layers The number of element layers in the last coordinate direction
+   *  \param rank   The rank of the process
+   *  \param size   The number of processes
+   */
+  inline std::pair<unsigned int, unsigned int> structuredSlab(unsigned int layers, int rank, int size)
+  {
+    const unsigned int base = layers / size;
+    const unsigned int rest = layers % size;
+    const unsigned int first = rank*base + std::min<unsigned int>(rank, rest);
+    return std::make_pair(first, first + base + (unsigned(rank) < rest ? 1 : 0));
+  }
+
+  /** \brief Fill coordinates with the coordinates of the vertices of a tensor product grid, one vertex after the other
+   *
+   *  \param coords    The vertex coordinates in each coordinate direction
+   *  \param lowerLeft Provides the coordinates dim,...,dimworld-1 of all vertices
+   *  \param first     The first element layer in the last direction
+   *  \param last      One past the last element layer in the last direction
+   */
+  template<int dimworld, class ctype, std::size_t dim>
+  void structuredVertices(const std::array<std::vector<ctype>, dim>& coords,
+                          const FieldVector<ctype, dimworld>& lowerLeft,
+                          std::vector<ctype>& coordinates,
+                          unsigned int first, unsigned int last)
+  {
+    static_assert(int(dim) <= dimworld, "The grid dimension must not exceed the world dimension");
+
+    std::size_t numRows = 1;
+    for (std::size_t j=1; j<dim; j++)
+      numRows *= (j == dim-1) ? last-first+1 : coords[j].size();
+
+    const std::size_t xBegin = (dim == 1) ? first : 0;
+    const std::size_t rowSize = (dim == 1) ? last-first+1 : coords[0].size();
+    coordinates.resize(numRows*rowSize*dimworld);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (long long row=0; row<(long long)numRows; row++)
+    {
+      // the coordinates shared by the row
+      FieldVector<ctype, dimworld> pos(lowerLeft);
+      std::size_t r = row;
+      for (std::size_t j=1; j<dim; j++)
+      {
+        const std::size_t extent = (j == dim-1) ? last-first+1 : coords[j].size();
+        pos[j] = coords[j][r % extent + ((j == dim-1) ? first : 0)];
+        r /= extent;
+      }
+
+      ctype* out = coordinates.data() + row*rowSize*dimworld;
+      for (std::size_t x=0; x<rowSize; x++)
+      {
+        pos[0] = coords[0][xBegin + x];
+        out = std::copy(pos.begin(), pos.end(), out);
+      }
+    }
+  }
+
+  namespace Impl
+  {
+
+    // Move the element template, given as corner offsets relative to the lowest
+    // corner of a cube, through all cubes of the layers [first, last)
+    template<std::size_t dim>
+    void structuredCorners(const std::array<unsigned int, dim>& elements,
+                           const std::vector<unsigned int>& cornerTemplate,
+                           std::vector<unsigned int>& corners,
+                           unsigned int first, unsigned int last)
+    {
+      std::array<unsigned int, dim> unitOffsets;
+      unitOffsets[0] = 1;
+      for (std::size_t j=1; j<dim; j++)
+        unitOffsets[j] = unitOffsets[j-1] * (elements[j-1]+1);
+
+      std::size_t numRows = 1;
+      for (std::size_t j=1; j<dim; j++)
+        numRows *= (j == dim-1) ? last-first : elements[j];
+
+      const unsigned int rowCubes = (dim == 1) ? last-first : elements[0];
+      const std::size_t cubeSize = cornerTemplate.size();
+      const std::size_t rowSize = rowCubes * cubeSize;
+      corners.resize(numRows*rowSize);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for (long long row=0; row<(long long)numRows; row++)
+      {
+        // lowest vertex of the first cube of the row, relative to the slab
+        unsigned int base = 0;
+        std::size_t r = row;
+        for (std::size_t j=1; j<dim; j++)
+        {
+          const unsigned int extent = (j == dim-1) ? last-first : elements[j];
+          base += (r % extent) * unitOffsets[j];
+          r /= extent;
+        }
+
+        unsigned int* out = corners.data() + row*rowSize;
+        for (unsigned int x=0; x<rowCubes; x++, base++)
+          for (std::size_t k=0; k<cubeSize; k++)
+            *out++ = base + cornerTemplate[k];
+      }
+    }
+
+  } // namespace Impl
+
+  /** \brief Fill corners with the vertices of the cubes of a structured grid, one cube after the other
+   *
+   *  \param elements The number of elements in each direction
+   *  \param first    The first element layer in the last direction
+   *  \param last     One past the last element layer in the last direction
+   */
+  template<std::size_t dim>
+  void structuredCubeCorners(const std::array<unsigned int, dim>& elements,
+                             std::vector<unsigned int>& corners,
+                             unsigned int first, unsigned int last)
+  {
+    // the corners of the cube at (0,...,0)
+    std::vector<unsigned int> cornerTemplate(1<<dim, 0);
+    for (std::size_t i=0; i<cornerTemplate.size(); i++)
+    {
+      unsigned int offset = 1;
+      for (std::size_t j=0; j<dim; j++)
+      {
+        if (i & (1<<j))
+          cornerTemplate[i] += offset;
+        offset *= elements[j]+1;
+      }
+    }
+
+    Impl::structuredCorners(elements, cornerTemplate, corners, first, last);
+  }
+
+  /** \brief Fill corners with the vertices of the simplices of a structured grid, one simplex after the other
+   *
+   *  Each cube is split into dim! simplices by the Coxeter-Freudenthal-Kuhn triangulation.
+   *
+   *  \param elements The number of cubes in each direction
+   *  \param first    The first cube layer in the last direction
+   *  \param last     One past the last cube layer in the last direction
+   */
+  template<std::size_t dim>
+  void structuredSimplexCorners(const std::array<unsigned int, dim>& elements,
+                                std::vector<unsigned int>& corners,
+                                unsigned int first, unsigned int last)
+  {
+    std::array<unsigned int, dim> unitOffsets;
+    unitOffsets[0] = 1;
+    for (std::size_t j=1; j<dim; j++)
+      unitOffsets[j] = unitOffsets[j-1] * (elements[j-1]+1);
+
+    // each permutation of the unit vectors gives a simplex of the cube at (0,...,0)
+    std::vector<unsigned int> cornerTemplate;
+    std::array<unsigned int, dim> permutation;
+    std::iota(permutation.begin(), permutation.end(), 0);
+    do {
+      unsigned int corner = 0;
+      cornerTemplate.push_back(corner);
+      for (std::size_t j=0; j<dim; j++)
+        cornerTemplate.push_back(corner += unitOffsets[permutation[j]]);
+    } while (std::next_permutation(permutation.begin(), permutation.end()));
+
+    Impl::structuredCorners(elements, cornerTemplate, corners, first, last);
+  }
+
+ } // namespace FactoryUtilities
+} // namespace Dune
+
+#endif // DUNE_GRID_UTILITY_STRUCTUREDCONNECTIVITY_HH
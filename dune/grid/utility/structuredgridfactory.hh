@@ -12,6 +12,7 @@
 #include <cstddef>
 #include <cstdlib>
 #include <memory>
+#include <vector>
 
 #include <dune/common/classname.hh>
 #include <dune/common/exceptions.hh>
@@ -19,6 +20,7 @@
 
 #include <dune/grid/common/gridfactory.hh>
 #include <dune/grid/utility/multiindex.hh>
+#include <dune/grid/utility/structuredconnectivity.hh>
 
 namespace Dune {
 
@@ -39,39 +41,26 @@ namespace Dune {
                                const FieldVector<ctype,dimworld>& upperRight,
                                const std::array<unsigned int,dim>& vertices)
     {
-      FactoryUtilities::MultiIndex<dim> index(vertices);
-
-      // Compute the total number of vertices to be created
-      int numVertices = index.cycle();
-
-      // Create vertices
-      for (int i=0; i<numVertices; i++, ++index) {
-
-        // scale the multiindex to obtain a world position
-        FieldVector<double,dimworld> pos(0);
-        for (int j=0; j<dim; j++)
-          pos[j] = lowerLeft[j] + index[j] * (upperRight[j]-lowerLeft[j])/(vertices[j]-1);
-        for (int j=dim; j<dimworld; j++)
-          pos[j] = lowerLeft[j];
-
-        factory.insertVertex(pos);
-
+      // the uniformly spaced coordinates in each direction
+      std::array<std::vector<ctype>,dim> coords;
+      for (int j=0; j<dim; j++) {
+        coords[j].resize(vertices[j]);
+        for (unsigned int i=0; i<vertices[j]; i++)
+          coords[j][i] = lowerLeft[j] + i * (upperRight[j]-lowerLeft[j])/(vertices[j]-1);
       }
 
+      std::vector<ctype> coordinates;
+      FactoryUtilities::structuredVertices(coords, lowerLeft, coordinates, 0, vertices[dim-1]-1);
+      factory.insertVertices(coordinates.data(), coordinates.size()/dimworld);
     }
 
-    // Compute the index offsets needed to move to the adjacent vertices
-    // in the different coordinate directions
-    static std::array<unsigned int, dim> computeUnitOffsets(const std::array<unsigned int,dim>& vertices)
+    // The number of vertices of a structured grid with the given number of elements
+    static std::size_t numVertices(const std::array<unsigned int,dim>& elements)
     {
-      std::array<unsigned int, dim> unitOffsets;
-      if (dim>0)        // paranoia
-        unitOffsets[0] = 1;
-
-      for (int i=1; i<dim; i++)
-        unitOffsets[i] = unitOffsets[i-1] * vertices[i-1];
-
-      return unitOffsets;
+      std::size_t n = 1;
+      for (int j=0; j<dim; j++)
+        n *= elements[j]+1;
+      return n;
     }
 
   public:
@@ -94,6 +83,13 @@ namespace Dune {
     {
       if (factory.comm().rank() == 0)
       {
+        // Generate all element corners in one pass
+        std::vector<unsigned int> corners;
+        FactoryUtilities::structuredCubeCorners(elements, corners, 0, elements[dim-1]);
+        const std::size_t numElements = corners.size() >> dim;
+
+        factory.reserve(numVertices(elements), numElements);
+
         // Insert uniformly spaced vertices
         std::array<unsigned int,dim> vertices = elements;
         for( size_t i = 0; i < vertices.size(); ++i )
@@ -102,43 +98,8 @@ namespace Dune {
         // Insert vertices for structured grid into the factory
         insertVertices(factory, lowerLeft, upperRight, vertices);
 
-        // Compute the index offsets needed to move to the adjacent
-        // vertices in the different coordinate directions
-        std::array<unsigned int, dim> unitOffsets =
-          computeUnitOffsets(vertices);
-
-        // Compute an element template (the cube at (0,...,0).  All
-        // other cubes are constructed by moving this template around
-        unsigned int nCorners = 1<<dim;
-
-        std::vector<unsigned int> cornersTemplate(nCorners,0);
-
-        for (size_t i=0; i<nCorners; i++)
-          for (int j=0; j<dim; j++)
-            if ( i & (1<<j) )
-              cornersTemplate[i] += unitOffsets[j];
-
         // Insert elements
-        FactoryUtilities::MultiIndex<dim> index(elements);
-
-        // Compute the total number of elementss to be created
-        int numElements = index.cycle();
-
-        for (int i=0; i<numElements; i++, ++index) {
-
-          // 'base' is the index of the lower left element corner
-          unsigned int base = 0;
-          for (int j=0; j<dim; j++)
-            base += index[j] * unitOffsets[j];
-
-          // insert new element
-          std::vector<unsigned int> corners = cornersTemplate;
-          for (size_t j=0; j<corners.size(); j++)
-            corners[j] += base;
-
-          factory.insertElement(GeometryTypes::cube(dim), corners);
-
-        }
+        factory.insertElements(GeometryTypes::cube(dim), corners.data(), numElements);
 
       }       // if(rank == 0)
     }
@@ -184,6 +145,14 @@ namespace Dune {
     {
       if(factory.comm().rank() == 0)
       {
+        // Generate the corners of all simplices in one pass.  Each cube is
+        // split up into dim! (factorial) simplices
+        std::vector<unsigned int> corners;
+        FactoryUtilities::structuredSimplexCorners(elements, corners, 0, elements[dim-1]);
+        const std::size_t numElements = corners.size() / (dim+1);
+
+        factory.reserve(numVertices(elements), numElements);
+
         // Insert uniformly spaced vertices
         std::array<unsigned int,dim> vertices = elements;
         for (std::size_t i=0; i<vertices.size(); i++)
@@ -191,44 +160,7 @@ namespace Dune {
 
         insertVertices(factory, lowerLeft, upperRight, vertices);
 
-        // Compute the index offsets needed to move to the adjacent
-        // vertices in the different coordinate directions
-        std::array<unsigned int, dim> unitOffsets =
-          computeUnitOffsets(vertices);
-
-        // Loop over all "cubes", and split up each cube into dim!
-        // (factorial) simplices
-        FactoryUtilities::MultiIndex<dim> elementsIndex(elements);
-        size_t cycle = elementsIndex.cycle();
-
-        for (size_t i=0; i<cycle; ++elementsIndex, i++) {
-
-          // 'base' is the index of the lower left element corner
-          unsigned int base = 0;
-          for (int j=0; j<dim; j++)
-            base += elementsIndex[j] * unitOffsets[j];
-
-          // each permutation of the unit vectors gives a simplex.
-          std::vector<unsigned int> permutation(dim);
-          for (int j=0; j<dim; j++)
-            permutation[j] = j;
-
-          do {
-
-            // Make a simplex
-            std::vector<unsigned int> corners(dim+1);
-            corners[0] = base;
-
-            for (int j=0; j<dim; j++)
-              corners[j+1] =
-                corners[j] + unitOffsets[permutation[j]];
-
-            factory.insertElement(GeometryTypes::simplex(dim), corners);
-
-          } while (std::next_permutation(permutation.begin(),
-                                         permutation.end()));
-
-        }
+        factory.insertElements(GeometryTypes::simplex(dim), corners.data(), numElements);
 
       }       // if(rank == 0)
     }
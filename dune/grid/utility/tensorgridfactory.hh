@@ -23,6 +23,7 @@
 #include <dune/grid/common/gridfactory.hh>
 #include <dune/grid/yaspgrid.hh>
 #include<dune/grid/utility/multiindex.hh>
+#include<dune/grid/utility/structuredconnectivity.hh>
 
 namespace Dune
 {
@@ -317,62 +318,22 @@ namespace Dune
       if (comm.rank() == 0)
       {
         // determine the size of the grid
-        std::array<unsigned int, dim> vsizes, esizes;
-        std::size_t size = 1;
+        const std::array<std::vector<ctype>, dim> coords = _factory.coords();
+        std::array<unsigned int, dim> esizes;
         for (std::size_t i = 0; i<dim; ++i)
-        {
-          vsizes[i] = _factory[i].size();
-          esizes[i] = vsizes[i] - 1;
-          size *= vsizes[i];
-        }
-
-        // insert all vertices
-        FactoryUtilities::MultiIndex<dim> index(vsizes);
-        for (std::size_t i=0; i<size; ++i, ++index)
-        {
-          Dune::FieldVector<ctype, dim> position;
-          for (std::size_t j = 0; j<dim; ++j)
-            position[j] = _factory[j][index[j]];
-          fac.insertVertex(position);
-        }
-
-        // compute the offsets
-        std::array<std::size_t, dim> offsets;
-        offsets[0] = 1;
-        for (std::size_t i=1; i<dim; i++)
-          offsets[i] = offsets[i-1] * vsizes[i-1];
-
-        // Compute an element template (the cube at (0,...,0).  All
-        // other cubes are constructed by moving this template around
-        unsigned int nCorners = 1<<dim;
-
-        std::vector<unsigned int> cornersTemplate(nCorners,0);
-
-        for (size_t i=0; i<nCorners; i++)
-          for (int j=0; j<dim; j++)
-            if ( i & (1<<j) )
-              cornersTemplate[i] += offsets[j];
-
-        // Insert elements
-        FactoryUtilities::MultiIndex<dim> eindex(esizes);
-
-        // Compute the total number of elements to be created
-        int numElements = eindex.cycle();
-
-        for (int i=0; i<numElements; i++, ++eindex)
-        {
-          // 'base' is the index of the lower left element corner
-          unsigned int base = 0;
-          for (int j=0; j<dim; j++)
-            base += eindex[j] * offsets[j];
-
-          // insert new element
-          std::vector<unsigned int> corners = cornersTemplate;
-          for (size_t j=0; j<corners.size(); j++)
-            corners[j] += base;
-
-          fac.insertElement(GeometryTypes::cube(dim), corners);
-        }
+          esizes[i] = coords[i].size() - 1;
+
+        // generate all vertices and elements in one pass each
+        std::vector<ctype> coordinates;
+        FactoryUtilities::structuredVertices(coords, FieldVector<ctype, dim>(0), coordinates, 0, esizes[dim-1]);
+        std::vector<unsigned int> corners;
+        FactoryUtilities::structuredCubeCorners(esizes, corners, 0, esizes[dim-1]);
+
+        const std::size_t numVertices = coordinates.size() / dim;
+        const std::size_t numElements = corners.size() >> dim;
+        fac.reserve(numVertices, numElements);
+        fac.insertVertices(coordinates.data(), numVertices);
+        fac.insertElements(GeometryTypes::cube(dim), corners.data(), numElements);
       }
 
       return std::unique_ptr<Grid>(fac.createGrid());
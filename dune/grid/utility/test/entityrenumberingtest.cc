@@ -0,0 +1,119 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+/** \file
+    \brief A unit test for the EntityRenumbering
+ */
+
+#include <config.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/test/testsuite.hh>
+
+#include <dune/grid/onedgrid.hh>
+#include <dune/grid/yaspgrid.hh>
+#include <dune/grid/utility/entityrenumbering.hh>
+
+using namespace Dune;
+
+// the new indices are a permutation, and subIndex, index and elementSeeds agree
+template<class GridView>
+TestSuite checkRenumbering (const GridView& gv, typename EntityRenumbering<GridView>::Ordering ordering)
+{
+  TestSuite t;
+  const int dim = GridView::dimension;
+
+  const EntityRenumbering<GridView> renumbering(gv, ordering);
+  t.check(renumbering.size(0) == std::size_t(gv.size(0))) << "wrong number of elements";
+  t.check(renumbering.size(dim) == std::size_t(gv.size(dim))) << "wrong number of vertices";
+
+  std::vector<int> elementCount(renumbering.size(0), 0), vertexCount(renumbering.size(dim), 0);
+  for (const auto& element : elements(gv))
+  {
+    const auto index = renumbering.index(element);
+    if (index >= renumbering.size(0))
+    {
+      t.check(false) << "element index out of range";
+      continue;
+    }
+    ++elementCount[index];
+    t.check(gv.grid().entity(renumbering.elementSeeds()[index]) == element) << "elementSeeds is not ordered by the new index";
+    t.check(renumbering.subIndex(element, 0, 0) == index) << "subIndex of the element itself is wrong";
+
+    for (unsigned int i = 0; i < element.subEntities(dim); ++i)
+      t.check(renumbering.subIndex(element, i, dim) == renumbering.index(element.template subEntity<dim>(i)))
+        << "subIndex and index of a vertex differ";
+  }
+  for (const auto& vertex : vertices(gv))
+  {
+    const auto index = renumbering.index(vertex);
+    t.check(index < renumbering.size(dim)) << "vertex index out of range";
+    if (index < renumbering.size(dim))
+      ++vertexCount[index];
+  }
+
+  for (int count : elementCount)
+    t.check(count == 1) << "element indices are not a permutation";
+  for (int count : vertexCount)
+    t.check(count == 1) << "vertex indices are not a permutation";
+
+  return t;
+}
+
+// the largest difference of the indices of two elements sharing a face
+template<class GridView, class Index>
+std::size_t elementBandwidth (const GridView& gv, const Index& index)
+{
+  std::size_t bandwidth = 0;
+  for (const auto& element : elements(gv))
+    for (const auto& intersection : intersections(gv, element))
+      if (intersection.neighbor())
+      {
+        const std::size_t i = index(element);
+        const std::size_t j = index(intersection.outside());
+        bandwidth = std::max(bandwidth, (i > j) ? i - j : j - i);
+      }
+  return bandwidth;
+}
+
+int main (int argc, char** argv)
+{
+  MPIHelper::instance(argc, argv);
+
+  TestSuite t;
+
+  {
+    typedef YaspGrid<2>::LeafGridView GridView;
+    YaspGrid<2> grid({1.0, 1.0}, {{8, 5}});
+    t.subTest(checkRenumbering(grid.leafGridView(), EntityRenumbering<GridView>::hilbert));
+    t.subTest(checkRenumbering(grid.leafGridView(), EntityRenumbering<GridView>::reverseCuthillMcKee));
+  }
+
+  // on a long structured grid, reverse Cuthill-McKee numbers across the short direction
+  {
+    typedef YaspGrid<2>::LeafGridView GridView;
+    YaspGrid<2> grid({4.0, 1.0}, {{16, 4}});
+    const GridView gv = grid.leafGridView();
+    const EntityRenumbering<GridView> renumbering(gv, EntityRenumbering<GridView>::reverseCuthillMcKee);
+    const std::size_t identity = elementBandwidth(gv, [&] (const auto& e) { return gv.indexSet().index(e); });
+    const std::size_t renumbered = elementBandwidth(gv, [&] (const auto& e) { return renumbering.index(e); });
+    t.check(renumbered <= identity)
+      << "reverse Cuthill-McKee increases the bandwidth from " << identity << " to " << renumbered;
+  }
+
+  {
+    typedef OneDGrid::LeafGridView GridView;
+    OneDGrid grid(7, 0.0, 1.0);
+    grid.mark(1, *grid.leafGridView().begin<0>());
+    grid.preAdapt();
+    grid.adapt();
+    grid.postAdapt();
+    t.subTest(checkRenumbering(grid.leafGridView(), EntityRenumbering<GridView>::hilbert));
+    t.subTest(checkRenumbering(grid.leafGridView(), EntityRenumbering<GridView>::reverseCuthillMcKee));
+  }
+
+  return t.exit();
+}
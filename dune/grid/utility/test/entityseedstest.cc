@@ -0,0 +1,77 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+/** \file
+    \brief A unit test for collecting entity seeds and obtaining entities from them
+ */
+
+#include <config.h>
+
+#include <type_traits>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/test/testsuite.hh>
+
+#include <dune/grid/onedgrid.hh>
+#include <dune/grid/yaspgrid.hh>
+#include <dune/grid/utility/entityseeds.hh>
+
+using namespace Dune;
+
+// the seeds of codimension codim are a compact copy of the traversal
+template<int codim, class GridView>
+TestSuite checkEntitySeeds (const GridView& gridView)
+{
+  TestSuite t;
+
+  typedef typename GridView::template Codim<codim>::Entity::EntitySeed Seed;
+  static_assert(std::is_trivially_copyable<Seed>::value, "Entity seeds have to be trivially copyable");
+
+  const auto seeds = entitySeeds<codim>(gridView);
+  t.check(seeds.size() == std::size_t(gridView.size(codim))) << "wrong number of seeds";
+
+  const auto entities = entitiesFromSeeds(gridView.grid(), seeds);
+  t.check(entities.size() == seeds.size()) << "wrong number of entities";
+
+  std::size_t i = 0;
+  for (const auto& entity : Dune::entities(gridView, Codim<codim>()))
+  {
+    if (i >= entities.size())
+      break;
+    t.check(entities[i] == entity) << "entity " << i << " differs from the traversal";
+    ++i;
+  }
+
+  return t;
+}
+
+int main (int argc, char** argv)
+{
+  MPIHelper::instance(argc, argv);
+
+  TestSuite t;
+
+  {
+    typedef YaspGrid<3> Grid;
+    static_assert(sizeof(Grid::Codim<0>::EntitySeed) == 4*sizeof(int), "YaspGrid seeds are not compact");
+
+    Grid grid({1.0, 1.0, 1.0}, {{3, 2, 2}});
+    grid.globalRefine(1);
+    t.subTest(checkEntitySeeds<0>(grid.leafGridView()));
+    t.subTest(checkEntitySeeds<1>(grid.leafGridView()));
+    t.subTest(checkEntitySeeds<3>(grid.leafGridView()));
+    t.subTest(checkEntitySeeds<0>(grid.levelGridView(0)));
+  }
+
+  {
+    typedef OneDGrid Grid;
+    static_assert(sizeof(Grid::Codim<0>::EntitySeed) == sizeof(void*), "OneDGrid seeds are not compact");
+
+    Grid grid(8, 0.0, 1.0);
+    grid.globalRefine(1);
+    t.subTest(checkEntitySeeds<0>(grid.leafGridView()));
+    t.subTest(checkEntitySeeds<1>(grid.leafGridView()));
+  }
+
+  return t.exit();
+}
@@ -0,0 +1,155 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+/** \file
+    \brief A unit test for the IntersectionCache
+ */
+
+#include <config.h>
+
+#include <array>
+#include <bitset>
+#include <cmath>
+
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/test/testsuite.hh>
+
+#include <dune/grid/onedgrid.hh>
+#include <dune/grid/yaspgrid.hh>
+#if HAVE_UG
+#include <dune/grid/uggrid.hh>
+#endif
+#if HAVE_ALBERTA
+#include <dune/grid/albertagrid.hh>
+#endif
+#include <dune/grid/utility/intersectioncache.hh>
+#include <dune/grid/utility/structuredgridfactory.hh>
+
+using namespace Dune;
+
+// compare the cache with the intersection iterators of the grid view
+template<class GridView>
+TestSuite checkIntersectionCache (const IntersectionCache<GridView>& cache)
+{
+  TestSuite t;
+
+  const GridView& gv = cache.gridView();
+  const auto& indexSet = gv.indexSet();
+
+  std::size_t size = 0;
+  for (const auto& element : elements(gv))
+  {
+    auto cached = cache.intersections(element).begin();
+    const auto cachedEnd = cache.intersections(element).end();
+    for (const auto& is : intersections(gv, element))
+    {
+      if (cached == cachedEnd)
+      {
+        t.check(false) << "too few cached intersections";
+        break;
+      }
+
+      t.check(cached->boundary() == is.boundary()) << "wrong boundary flag";
+      t.check(cached->neighbor() == is.neighbor()) << "wrong neighbor flag";
+      t.check(cached->indexInInside() == is.indexInInside()) << "wrong indexInInside";
+      if (is.boundary())
+        t.check(cached->boundarySegmentIndex() == is.boundarySegmentIndex()) << "wrong boundary segment index";
+      if (is.neighbor())
+      {
+        t.check(cached->indexInOutside() == is.indexInOutside()) << "wrong indexInOutside";
+        t.check(indexSet.index(cache.outside(*cached)) == indexSet.index(is.outside())) << "wrong outside element";
+      }
+
+      auto normal = cached->centerUnitOuterNormal();
+      normal -= is.centerUnitOuterNormal();
+      t.check(normal.two_norm() < 1e-12) << "wrong normal";
+
+      const auto geometry = is.geometry();
+      t.check(std::abs(cached->volume() - geometry.volume()) < 1e-12) << "wrong volume";
+      t.check(cached->geometry().corners() == geometry.corners()) << "wrong number of corners";
+      auto center = cached->geometry().center();
+      center -= geometry.center();
+      t.check(center.two_norm() < 1e-12) << "wrong face geometry";
+
+      ++cached;
+      ++size;
+    }
+    t.check(cached == cachedEnd) << "too many cached intersections";
+  }
+  t.check(size == cache.size()) << "wrong number of cached intersections";
+
+  return t;
+}
+
+// refine the first leaf element of an unstructured grid and check the updated cache
+template<class Grid>
+TestSuite checkUnstructuredGrid (Grid& grid)
+{
+  TestSuite t;
+
+  IntersectionCache<typename Grid::LeafGridView> cache(grid.leafGridView());
+  t.subTest(checkIntersectionCache(cache));
+
+  grid.mark(1, *grid.leafGridView().template begin<0>());
+  grid.preAdapt();
+  grid.adapt();
+  grid.postAdapt();
+  cache.update();
+  t.subTest(checkIntersectionCache(cache));
+
+  return t;
+}
+
+int main (int argc, char** argv)
+{
+  MPIHelper::instance(argc, argv);
+
+  TestSuite t;
+
+  {
+    // a periodic grid has intersections that are boundary and neighbor at once
+    YaspGrid<2> grid({1.0, 1.0}, {{3, 4}}, std::bitset<2>(1ULL), 0);
+    IntersectionCache<YaspGrid<2>::LeafGridView> cache(grid.leafGridView());
+    t.subTest(checkIntersectionCache(cache));
+
+    grid.globalRefine(1);
+    cache.update();
+    t.subTest(checkIntersectionCache(cache));
+  }
+
+  {
+    OneDGrid grid(8, 0.0, 1.0);
+    IntersectionCache<OneDGrid::LeafGridView> cache(grid.leafGridView());
+    t.subTest(checkIntersectionCache(cache));
+
+    // local refinement changes the element sizes and indices
+    grid.mark(1, *grid.leafGridView().begin<0>());
+    grid.preAdapt();
+    grid.adapt();
+    grid.postAdapt();
+    cache.update();
+    t.subTest(checkIntersectionCache(cache));
+  }
+
+#if HAVE_UG
+  {
+    typedef UGGrid<2> Grid;
+    FieldVector<double, 2> lower(0.0), upper(1.0);
+    auto grid = StructuredGridFactory<Grid>::createSimplexGrid(lower, upper, {{4, 4}});
+    t.subTest(checkUnstructuredGrid(*grid));
+  }
+#endif // #if HAVE_UG
+
+#if HAVE_ALBERTA
+  {
+    typedef AlbertaGrid<ALBERTA_DIM> Grid;
+    FieldVector<double, ALBERTA_DIM> lower(0.0), upper(1.0);
+    std::array<unsigned int, ALBERTA_DIM> cells;
+    cells.fill(4);
+    auto grid = StructuredGridFactory<Grid>::createSimplexGrid(lower, upper, cells);
+    t.subTest(checkUnstructuredGrid(*grid));
+  }
+#endif // #if HAVE_ALBERTA
+
+  return t.exit();
+}
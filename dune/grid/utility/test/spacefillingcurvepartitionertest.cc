@@ -0,0 +1,128 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#include "config.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/test/testsuite.hh>
+
+#include <dune/grid/yaspgrid.hh>
+#include <dune/grid/common/mcmgmapper.hh>
+#include <dune/grid/utility/spacefillingcurvepartitioner.hh>
+
+using namespace Dune;
+
+/** \brief Check that the Hilbert curve visits the cells of a coarse lattice through face neighbors */
+template<int dim>
+TestSuite checkHilbertCurve (int levels)
+{
+  TestSuite t;
+  typedef SpaceFillingCurvePartitioner<typename YaspGrid<dim>::LeafGridView> Partitioner;
+  typedef std::array<std::uint32_t, dim> Cell;
+
+  // the lower left corners of the cells of a lattice with 2^levels cells per direction
+  std::vector<Cell> cells;
+  Cell c;
+  std::fill(c.begin(), c.end(), 0);
+  const std::uint32_t n = 1u << levels;
+  const int shift = Partitioner::bits - levels;
+  while (true)
+  {
+    Cell x;
+    for (int i=0; i<dim; i++)
+      x[i] = c[i] << shift;
+    cells.push_back(x);
+
+    int i = 0;
+    for (; i<dim; i++)
+      if (++c[i] < n)
+        break;
+      else
+        c[i] = 0;
+    if (i == dim)
+      break;
+  }
+
+  std::sort(cells.begin(), cells.end(), [](const Cell& a, const Cell& b)
+  {
+    return Partitioner::hilbertKey(a) < Partitioner::hilbertKey(b);
+  });
+
+  for (std::size_t k=1; k<cells.size(); k++)
+  {
+    std::uint32_t distance = 0;
+    for (int i=0; i<dim; i++)
+      distance += std::max(cells[k][i], cells[k-1][i]) - std::min(cells[k][i], cells[k-1][i]);
+    t.check(distance == (1u << shift)) << "consecutive cells on the Hilbert curve are not face neighbors";
+  }
+
+  return t;
+}
+
+/** \brief Check that a partition of a grid is balanced with respect to the given weight */
+template<class GridView, class Weight>
+TestSuite checkPartition (const GridView& gv, const Weight& weight, bool hilbert)
+{
+  TestSuite t;
+  typedef SpaceFillingCurvePartitioner<GridView> Partitioner;
+  const auto curve = hilbert ? Partitioner::hilbert : Partitioner::morton;
+
+  const std::vector<unsigned> part = Partitioner::partition(gv, weight, curve);
+  t.require(part.size() == gv.size(0)) << "partition has wrong size";
+
+  const int P = gv.comm().size();
+  MultipleCodimMultipleGeomTypeMapper<GridView> mapper(gv, mcmgElementLayout());
+  std::vector<double> load(P, 0.0);
+  double maxWeight = 0.0;
+  for (const auto& element : elements(gv, Partitions::interior))
+  {
+    const unsigned p = part[mapper.index(element)];
+    t.require(int(p) < P) << "target rank out of range";
+    load[p] += weight(element);
+    maxWeight = std::max(maxWeight, weight(element));
+  }
+  gv.comm().sum(load.data(), P);
+  maxWeight = gv.comm().max(maxWeight);
+
+  double total = 0.0;
+  for (double l : load)
+    total += l;
+  for (int p=0; p<P; p++)
+    t.check(std::abs(load[p] - total/P) <= maxWeight + 1e-8)
+      << "piece " << p << " has load " << load[p] << " instead of " << total/P;
+
+  // the partition is repeatable
+  t.check(Partitioner::partition(gv, weight, curve) == part) << "partition is not repeatable";
+
+  return t;
+}
+
+int main (int argc, char** argv)
+{
+  MPIHelper::instance(argc, argv);
+
+  TestSuite t;
+  t.subTest(checkHilbertCurve<2>(4));
+  t.subTest(checkHilbertCurve<3>(3));
+
+  YaspGrid<2> grid2({1.0, 1.0}, {{24, 20}});
+  YaspGrid<3> grid3({1.0, 1.0, 1.0}, {{8, 10, 6}});
+
+  auto unit = [](const auto&) { return 1.0; };
+  auto graded = [](const auto& e) { return 1.0 + 10.0*e.geometry().center()[0]; };
+
+  for (bool hilbert : {true, false})
+  {
+    t.subTest(checkPartition(grid2.leafGridView(), unit, hilbert));
+    t.subTest(checkPartition(grid2.leafGridView(), graded, hilbert));
+    t.subTest(checkPartition(grid3.leafGridView(), unit, hilbert));
+    t.subTest(checkPartition(grid3.leafGridView(), graded, hilbert));
+  }
+
+  return t.exit();
+}
@@ -0,0 +1,118 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+/** \file
+    \brief A unit test for the structured vertex and element generators
+ */
+
+#include <config.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+#include <dune/common/test/testsuite.hh>
+
+#include <dune/grid/utility/multiindex.hh>
+#include <dune/grid/utility/structuredconnectivity.hh>
+
+using Dune::TestSuite;
+using namespace Dune::FactoryUtilities;
+
+// compare with the element by element construction
+template<std::size_t dim>
+TestSuite checkStructuredConnectivity (const std::array<unsigned int,dim>& elements)
+{
+  TestSuite t;
+
+  std::array<unsigned int,dim> vertices = elements;
+  for (auto& v : vertices)
+    v++;
+
+  std::array<unsigned int,dim> unitOffsets;
+  unitOffsets[0] = 1;
+  for (std::size_t j=1; j<dim; j++)
+    unitOffsets[j] = unitOffsets[j-1] * vertices[j-1];
+
+  std::vector<unsigned int> cubes, simplices;
+  MultiIndex<dim> index(elements);
+  const std::size_t numCubes = index.cycle();
+  for (std::size_t i=0; i<numCubes; i++, ++index)
+  {
+    unsigned int base = 0;
+    for (std::size_t j=0; j<dim; j++)
+      base += index[j] * unitOffsets[j];
+
+    for (unsigned int c=0; c<(1u<<dim); c++)
+    {
+      unsigned int corner = base;
+      for (std::size_t j=0; j<dim; j++)
+        if (c & (1<<j))
+          corner += unitOffsets[j];
+      cubes.push_back(corner);
+    }
+
+    std::array<unsigned int,dim> permutation;
+    for (std::size_t j=0; j<dim; j++)
+      permutation[j] = j;
+    do {
+      unsigned int corner = base;
+      simplices.push_back(corner);
+      for (std::size_t j=0; j<dim; j++)
+        simplices.push_back(corner += unitOffsets[permutation[j]]);
+    } while (std::next_permutation(permutation.begin(), permutation.end()));
+  }
+
+  std::vector<unsigned int> corners;
+  structuredCubeCorners(elements, corners, 0, elements[dim-1]);
+  t.check(corners == cubes) << "wrong cube corners in " << dim << "d";
+
+  structuredSimplexCorners(elements, corners, 0, elements[dim-1]);
+  t.check(corners == simplices) << "wrong simplex corners in " << dim << "d";
+
+  // the slabs of several processes together give the whole grid
+  for (int size : {1, 2, 3})
+  {
+    std::vector<unsigned int> all;
+    for (int rank=0; rank<size; rank++)
+    {
+      const auto slab = structuredSlab(elements[dim-1], rank, size);
+      structuredCubeCorners(elements, corners, slab.first, slab.second);
+      for (unsigned int corner : corners)
+        all.push_back(corner + slab.first*unitOffsets[dim-1]);
+    }
+    t.check(all == cubes) << "slabs of " << size << " processes do not match the grid in " << dim << "d";
+  }
+
+  // vertex coordinates, with one additional world dimension
+  std::array<std::vector<double>,dim> coords;
+  for (std::size_t j=0; j<dim; j++)
+    for (unsigned int i=0; i<vertices[j]; i++)
+      coords[j].push_back(i*i + 10.0*j);
+
+  std::vector<double> coordinates;
+  structuredVertices(coords, Dune::FieldVector<double,dim+1>(-1.0), coordinates, 0, elements[dim-1]);
+
+  MultiIndex<dim> vertexIndex(vertices);
+  const std::size_t numVertices = vertexIndex.cycle();
+  t.require(coordinates.size() == numVertices*(dim+1)) << "wrong number of vertex coordinates";
+  for (std::size_t i=0; i<numVertices; i++, ++vertexIndex)
+  {
+    for (std::size_t j=0; j<dim; j++)
+      t.check(coordinates[i*(dim+1)+j] == coords[j][vertexIndex[j]]) << "wrong vertex coordinate";
+    t.check(coordinates[i*(dim+1)+dim] == -1.0) << "wrong additional vertex coordinate";
+  }
+
+  return t;
+}
+
+int main ()
+{
+  TestSuite t;
+
+  t.subTest(checkStructuredConnectivity<1>({{5}}));
+  t.subTest(checkStructuredConnectivity<2>({{3, 4}}));
+  t.subTest(checkStructuredConnectivity<3>({{2, 3, 5}}));
+
+  return t.exit();
+}
@@ -31,6 +31,7 @@ typedef unsigned char uint8_t;
 #include <dune/geometry/type.hh>
 #include <dune/grid/common/indexidset.hh>
 #include <dune/grid/common/datahandleif.hh>
+#include <dune/grid/common/instrumentation.hh>
 
 
 #if HAVE_MPI
@@ -653,6 +654,16 @@ namespace Dune {
       // process receive buffers and compute intersections
       for (typename Torus<CollectiveCommunicationType,dim>::ProcListIterator i=_torus.recvbegin(); i!=_torus.recvend(); ++i)
       {
+        // translation from the coordinates of the neighbor to our own
+        iTupel move;
+        iTupel coord = _torus.coord();
+        iTupel delta = i.delta();
+        for (int k=0; k<dim; k++)
+        {
+          int nb = coord[k] + delta[k];
+          move[k] = (nb < 0) ? -size[k] : ((nb >= _torus.dims(k)) ? size[k] : 0);
+        }
+
         // what must be sent to this neighbor
         Intersection send_intersection;
         mpifriendly_ygrid yg = mpifriendly_recv_recvgrid[i.index()];
@@ -660,6 +671,7 @@ namespace Dune {
         send_intersection.grid = sendgrid.intersection(recv_recvgrid[i.index()]);
         send_intersection.rank = i.rank();
         send_intersection.distance = i.distance();
+        send_intersection.move = move;
         if (!send_intersection.grid.empty()) sendlist.push_front(send_intersection);
 
         Intersection recv_intersection;
@@ -668,6 +680,7 @@ namespace Dune {
         recv_intersection.grid = recvgrid.intersection(recv_sendgrid[i.index()]);
         recv_intersection.rank = i.rank();
         recv_intersection.distance = i.distance();
+        recv_intersection.move = move;
         if(!recv_intersection.grid.empty()) recvlist.push_back(recv_intersection);
       }
     }
@@ -1280,6 +1293,20 @@ namespace Dune {
       keep_ovlp = keepPhysicalOverlap;
     }
 
+    /**
+       \brief set options for communication
+       @param useNeighborCollectives [true] exchange messages with the neighboring processes by MPI-3
+              neighborhood collectives, [false] use point-to-point messages.  Default is [false].
+       @param useSharedMemory [true] pass messages to processes on the same node through an MPI-3
+              shared-memory window, [false] send them like messages to other nodes.  Default is [false].
+       \note This method is collective on the communicator of the grid.
+     */
+    void communicationOptions (bool useNeighborCollectives, bool useSharedMemory = false)
+    {
+      _torus.useNeighborCollectives(useNeighborCollectives);
+      _torus.useSharedMemory(useSharedMemory);
+    }
+
     /** \brief Marks an entity to be refined/coarsened in a subsequent adapt.
 
        \param[in] refCount Number of subdivisions that should be applied. Negative value means coarsening.
@@ -1502,6 +1529,8 @@ namespace Dune {
       // check input
       if (!data.contains(dim,codim)) return; // should have been checked outside
 
+      DUNE_GRID_INSTRUMENT_REGION(region, "YaspGrid::communicate", codim, iftype);
+
       // data types
       typedef typename DataHandle::DataType DataType;
 
@@ -1596,6 +1625,7 @@ namespace Dune {
 
           // hand over send request to torus class
           torus().send(is->rank,buf,is->grid.totalsize()*sizeof(size_t));
+          DUNE_GRID_INSTRUMENT_BYTES(region, is->grid.totalsize()*sizeof(size_t));
           cnt++;
         }
 
@@ -1667,6 +1697,7 @@ namespace Dune {
 
         // hand over send request to torus class
         torus().send(is->rank,buf,send_size[cnt]*sizeof(DataType));
+        DUNE_GRID_INSTRUMENT_BYTES(region, send_size[cnt]*sizeof(DataType));
         cnt++;
       }
 
@@ -2039,5 +2070,7 @@ namespace Dune {
 #include <dune/grid/yaspgrid/structuredyaspgridfactory.hh>
 // Include the specialization of the BackupRestoreFacility class for YaspGrid
 #include <dune/grid/yaspgrid/backuprestore.hh>
+// Include the structured box view onto the index sets of YaspGrid
+#include <dune/grid/yaspgrid/yaspgridboxview.hh>
 
 #endif
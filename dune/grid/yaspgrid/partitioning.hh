@@ -8,8 +8,17 @@
  *  for already available useful partitioners, like YaspFixedSizePartitioner.
  */
 
+#include<algorithm>
 #include<array>
+#include<cmath>
+#include<functional>
+#include<vector>
 
+#if HAVE_MPI
+#include<mpi.h>
+#endif
+
+#include<dune/common/exceptions.hh>
 #include<dune/common/power.hh>
 
 namespace Dune
@@ -26,6 +35,32 @@ namespace Dune
     typedef std::array<int, d> iTupel;
     virtual ~YLoadBalance() {}
     virtual void loadbalance(const iTupel&, int, iTupel&) const = 0;
+
+    /** \brief assign the ranks to positions in the process torus
+     *
+     * \param [in]  dims   dimensions of the torus as computed by loadbalance()
+     * \param [in]  P      number of processors
+     * \param [out] coords position of each rank in the torus. Leaving it empty (the default)
+     *                     places the ranks in lexicographic order.
+     */
+    virtual void rankCoordinates(const iTupel& /* dims */, int /* P */, std::vector<iTupel>& coords) const
+    {
+      coords.clear();
+    }
+
+    /** \brief positions of the cuts between the processors in each direction
+     *
+     * \param [in]  size number of elements in each coordinate direction, for the entire grid
+     * \param [in]  dims dimensions of the torus as computed by loadbalance()
+     * \param [out] cuts cuts[i] holds dims[i]+1 increasing positions from 0 to size[i].
+     *                   Leaving it empty (the default) splits each direction into
+     *                   slabs of (nearly) equal size.
+     */
+    virtual void cuts(const iTupel& /* size */, const iTupel& /* dims */, std::array<std::vector<int>, d>& cuts) const
+    {
+      for (auto& c : cuts)
+        c.clear();
+    }
   };
 
   /** \brief Implement the default load balance strategy of yaspgrid
@@ -133,6 +168,462 @@ namespace Dune
     std::array<int,d> _dims;
   };
 
+  /** \brief Partitioner balancing a given cost per element by variable cut positions
+   *
+   * The processor numbers per direction are determined as by YLoadBalanceDefault
+   * or given explicitly.  The cut positions along each axis are then chosen such
+   * that the maximum cost of a processor is small, while the partition remains a
+   * tensor product: starting from cuts balancing the cost projected onto each axis,
+   * each direction is in turn re-cut optimally for the cuts in the other directions.
+   *
+   * The cost is evaluated for the elements of the coarse grid, given by their
+   * integer coordinate.  On refined levels the cuts are refined along with the grid.
+   * As for the default partitioning, the overlap must not be wider than the
+   * piece of a neighboring processor.
+   *
+   * \code
+   * // elements close to x=0 are ten times as expensive
+   * YaspWeightedPartitioner<dim> partitioner([](const std::array<int,dim>& e){ return e[0] < 8 ? 10.0 : 1.0; });
+   * YaspGrid<dim> grid(upper, cells, periodic, overlap, comm, &partitioner);
+   * \endcode
+   */
+  template<int d>
+  class YaspWeightedPartitioner : public YLoadBalance<d>
+  {
+  public:
+    typedef std::array<int, d> iTupel;
+    typedef std::function<double(const iTupel&)> Cost;
+
+    //! construct from the cost of each element of the coarse grid
+    explicit YaspWeightedPartitioner (const Cost& cost)
+      : _cost(cost), _fixedDims(false)
+    {}
+
+    //! construct from the element cost and a fixed number of processors per direction
+    YaspWeightedPartitioner (const Cost& cost, const iTupel& dims)
+      : _cost(cost), _dims(dims), _fixedDims(true)
+    {}
+
+    /** \brief construct from separable costs per slab
+     *
+     * The cost of an element is the product of the costs of the slabs
+     * it is contained in, weights[i][k] being the cost of slab k in direction i.
+     */
+    explicit YaspWeightedPartitioner (const std::array<std::vector<double>, d>& weights)
+      : _fixedDims(false)
+    {
+      _cost = [weights](const iTupel& e)
+      {
+        double c = 1.0;
+        for (int i=0; i<d; i++)
+          c *= weights[i][e[i]];
+        return c;
+      };
+    }
+
+    virtual ~YaspWeightedPartitioner() {}
+
+    virtual void loadbalance (const iTupel& size, int P, iTupel& dims) const
+    {
+      if (!_fixedDims)
+      {
+        YLoadBalanceDefault<d>().loadbalance(size, P, dims);
+        return;
+      }
+
+      int prod = 1;
+      for (int i=0; i<d; i++)
+        prod *= _dims[i];
+      if (P != prod)
+        DUNE_THROW(Dune::Exception,"Your processor number doesn't match your partitioning information");
+      dims = _dims;
+    }
+
+    virtual void cuts (const iTupel& size, const iTupel& dims, std::array<std::vector<int>, d>& cuts) const
+    {
+      for (int i=0; i<d; i++)
+        if (size[i] < dims[i])
+          DUNE_THROW(Dune::Exception, "YaspWeightedPartitioner: fewer elements than processors in direction " << i);
+
+      // evaluate the cost of all elements, lexicographically ordered
+      std::size_t n = 1;
+      for (int i=0; i<d; i++)
+        n *= size[i];
+      std::vector<double> cost(n);
+      iTupel e;
+      std::fill(e.begin(), e.end(), 0);
+      for (std::size_t k=0; k<n; k++)
+      {
+        cost[k] = _cost(e);
+        for (int i=0; i<d; i++)
+          if (++e[i] < size[i])
+            break;
+          else
+            e[i] = 0;
+      }
+
+      // start with all cuts at the ends, hence balancing the projected cost
+      for (int i=0; i<d; i++)
+        cuts[i] = {0, size[i]};
+
+      // re-cut each direction for the current cuts in the other directions
+      for (int sweep=0; sweep<3; sweep++)
+        for (int i=0; i<d; i++)
+        {
+          std::array<std::vector<int>, d> current(cuts);
+          current[i] = {0, size[i]};
+          const auto load = slabLoads(size, cost, current, i);
+          cuts[i] = cut(load, size[i], dims[i]);
+        }
+    }
+
+  private:
+    // cost of each slab in direction dir, for each block of the cuts in the other directions
+    static std::vector<std::vector<double> > slabLoads (const iTupel& size, const std::vector<double>& cost,
+                                                        const std::array<std::vector<int>, d>& cuts, int dir)
+    {
+      // block number of each element coordinate in each direction
+      std::array<std::vector<int>, d> block;
+      iTupel blocks;
+      for (int i=0; i<d; i++)
+      {
+        block[i].resize(size[i]);
+        for (std::size_t j=1; j<cuts[i].size(); j++)
+          for (int k=cuts[i][j-1]; k<cuts[i][j]; k++)
+            block[i][k] = j-1;
+        blocks[i] = cuts[i].size()-1;
+      }
+
+      int others = 1;
+      for (int i=0; i<d; i++)
+        if (i != dir)
+          others *= blocks[i];
+
+      std::vector<std::vector<double> > load(size[dir], std::vector<double>(others, 0.0));
+      iTupel e;
+      std::fill(e.begin(), e.end(), 0);
+      for (std::size_t k=0; k<cost.size(); k++)
+      {
+        int b = 0;
+        for (int i=d-1; i>=0; i--)
+          if (i != dir)
+            b = b*blocks[i] + block[i][e[i]];
+        load[e[dir]][b] += cost[k];
+
+        for (int i=0; i<d; i++)
+          if (++e[i] < size[i])
+            break;
+          else
+            e[i] = 0;
+      }
+      return load;
+    }
+
+    // greedily cut the slabs into at most P pieces with a load of at most bound in each block
+    static bool feasible (const std::vector<std::vector<double> >& load, int P, double bound, std::vector<int>& cuts)
+    {
+      const int n = load.size();
+      const std::size_t blocks = load[0].size();
+      std::vector<double> sum(blocks, 0.0);
+      cuts.assign(1, 0);
+      for (int k=0; k<n; k++)
+      {
+        bool fits = true;
+        for (std::size_t b=0; b<blocks; b++)
+        {
+          if (load[k][b] > bound)
+            return false;
+          fits = fits && (sum[b] + load[k][b] <= bound);
+        }
+        if (!fits)
+        {
+          cuts.push_back(k);
+          std::fill(sum.begin(), sum.end(), 0.0);
+        }
+        for (std::size_t b=0; b<blocks; b++)
+          sum[b] += load[k][b];
+      }
+      cuts.push_back(n);
+      return int(cuts.size())-1 <= P;
+    }
+
+    // optimal cuts of n slabs into P pieces minimizing the maximum load of a block
+    static std::vector<int> cut (const std::vector<std::vector<double> >& load, int n, int P)
+    {
+      double lower = 0.0, upper = 0.0;
+      for (const auto& slab : load)
+        for (double l : slab)
+          upper += l;
+
+      std::vector<int> cuts, trial;
+      if (upper <= 0.0)
+      {
+        // no cost at all, use equal slabs
+        for (int j=0; j<=P; j++)
+          cuts.push_back((long(j)*n)/P);
+        return cuts;
+      }
+
+      feasible(load, P, upper, cuts);
+      for (int it=0; it<60 && upper-lower > 1e-12*upper; it++)
+      {
+        const double bound = 0.5*(lower+upper);
+        if (feasible(load, P, bound, trial))
+        {
+          upper = bound;
+          cuts.swap(trial);
+        }
+        else
+          lower = bound;
+      }
+
+      // use up the remaining processors by splitting off single slabs, which only lowers the load
+      for (int k=n-1; int(cuts.size())-1 < P; k--)
+        if (!std::binary_search(cuts.begin(), cuts.end(), k))
+          cuts.insert(std::lower_bound(cuts.begin(), cuts.end(), k), k);
+
+      return cuts;
+    }
+
+    Cost _cost;
+    iTupel _dims;
+    bool _fixedDims;
+  };
+
+  /** \brief Partitioner taking the placement of the ranks onto shared-memory nodes into account
+   *
+   * The process torus is factorized hierarchically: the grid is first split into
+   * one block per node such that the surface between nodes is minimal, then each
+   * node block is split among the ranks of that node.  Messages between torus
+   * neighbors thus mostly stay within a node.  Among all factorizations, only those
+   * with the best load balance in the sense of YLoadBalanceDefault are considered.
+   *
+   * The node layout is determined with MPI_Comm_split_type(MPI_COMM_TYPE_SHARED)
+   * or can be given explicitly.  If the nodes host different numbers of ranks, or
+   * the layout is not known, the partitioner falls back to the default strategy.
+   *
+   * \code
+   * YaspNodeAwarePartitioner<dim> partitioner(MPI_COMM_WORLD);
+   * YaspGrid<dim> grid(upper, cells, periodic, overlap, MPI_COMM_WORLD, &partitioner);
+   * \endcode
+   */
+  template<int d>
+  class YaspNodeAwarePartitioner : public YLoadBalance<d>
+  {
+  public:
+    typedef std::array<int, d> iTupel;
+
+#if HAVE_MPI
+    /** \brief determine the node layout of the ranks of a communicator
+     *
+     * This is a collective operation on \a comm, which has to be the
+     * communicator the grid is constructed with.
+     */
+    explicit YaspNodeAwarePartitioner (MPI_Comm comm)
+    {
+      int rank, size;
+      MPI_Comm_rank(comm, &rank);
+      MPI_Comm_size(comm, &size);
+
+      // identify each node by the smallest rank running on it
+      int node = rank;
+#if MPI_VERSION >= 3
+      MPI_Comm nodeComm;
+      MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &nodeComm);
+      MPI_Allreduce(&rank, &node, 1, MPI_INT, MPI_MIN, nodeComm);
+      MPI_Comm_free(&nodeComm);
+#endif
+      std::vector<int> nodes(size);
+      MPI_Allgather(&node, 1, MPI_INT, nodes.data(), 1, MPI_INT, comm);
+      setNodes(nodes);
+    }
+#endif
+
+    /** \brief construct from a given node layout
+     *
+     * \param nodes node number of each rank, ranks with equal numbers share a node
+     */
+    explicit YaspNodeAwarePartitioner (const std::vector<int>& nodes)
+    {
+      setNodes(nodes);
+    }
+
+    virtual ~YaspNodeAwarePartitioner() {}
+
+    virtual void loadbalance (const iTupel& size, int P, iTupel& dims) const
+    {
+      if (factorize(size, P, dims, _nodeDims))
+        _dims = dims;
+      else
+      {
+        YLoadBalanceDefault<d>().loadbalance(size, P, dims);
+        _dims = {};
+      }
+    }
+
+    virtual void rankCoordinates (const iTupel& dims, int P, std::vector<iTupel>& coords) const
+    {
+      coords.clear();
+      if (int(_local.size()) != P || _ranksPerNode <= 0 || dims != _dims)
+        return;
+
+      const iTupel& nodeDims = _nodeDims;
+      iTupel rankDims;
+      for (int i=0; i<d; i++)
+        rankDims[i] = dims[i] / nodeDims[i];
+
+      coords.resize(P);
+      for (int r=0; r<P; r++)
+      {
+        const iTupel nodeCoord = lexicographic(_node[r], nodeDims);
+        const iTupel rankCoord = lexicographic(_local[r], rankDims);
+        for (int i=0; i<d; i++)
+          coords[r][i] = nodeCoord[i]*rankDims[i] + rankCoord[i];
+      }
+    }
+
+    //! number of nodes, 0 if the ranks are not evenly distributed among the nodes
+    int nodes () const
+    {
+      return (_ranksPerNode > 0) ? int(_local.size()) / _ranksPerNode : 0;
+    }
+
+  private:
+    void setNodes (const std::vector<int>& nodes)
+    {
+      const int P = nodes.size();
+      _node.assign(P, 0);
+      _local.assign(P, 0);
+
+      // number the nodes and the ranks within each node consecutively
+      std::vector<int> ids(nodes);
+      std::sort(ids.begin(), ids.end());
+      ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+      std::vector<int> count(ids.size(), 0);
+      for (int r=0; r<P; r++)
+      {
+        _node[r] = std::lower_bound(ids.begin(), ids.end(), nodes[r]) - ids.begin();
+        _local[r] = count[_node[r]]++;
+      }
+
+      _ranksPerNode = count.empty() ? 0 : count[0];
+      for (int c : count)
+        if (c != _ranksPerNode)
+          _ranksPerNode = 0;
+    }
+
+    static iTupel lexicographic (int n, const iTupel& dims)
+    {
+      iTupel c;
+      for (int i=0; i<d; i++)
+      {
+        c[i] = n % dims[i];
+        n /= dims[i];
+      }
+      return c;
+    }
+
+    // call f for each d-tuple of positive integers with product P
+    template<class F>
+    static void forEachFactorization (int P, F&& f)
+    {
+      iTupel t;
+      forEachFactorization(d-1, P, t, f);
+    }
+
+    template<class F>
+    static void forEachFactorization (int i, int P, iTupel& t, F& f)
+    {
+      if (i == 0)
+      {
+        t[0] = P;
+        f(t);
+        return;
+      }
+      for (int k=1; k<=P; k++)
+        if (P%k == 0)
+        {
+          t[i] = k;
+          forEachFactorization(i-1, P/k, t, f);
+        }
+    }
+
+    // load balance norm of YLoadBalanceDefault, smaller is better
+    static double balance (const iTupel& size, const iTupel& dims)
+    {
+      double m = -1.0;
+      for (int k=0; k<d; k++)
+      {
+        double mm = ((double)size[k])/((double)dims[k]);
+        if (std::fmod((double)size[k], (double)dims[k]) > 0.0001) mm *= 3;
+        m = std::max(m, mm);
+      }
+      return m;
+    }
+
+    // surface of the cuts between the blocks of a torus with given dimensions
+    static double surface (const iTupel& size, const iTupel& dims)
+    {
+      double s = 0.0;
+      for (int k=0; k<d; k++)
+      {
+        double face = dims[k] - 1;
+        for (int j=0; j<d; j++)
+          if (j != k)
+            face *= size[j];
+        s += face;
+      }
+      return s;
+    }
+
+    // find dims with best load balance, and among those the node split with the smallest inter-node surface
+    bool factorize (const iTupel& size, int P, iTupel& dims, iTupel& nodeDims) const
+    {
+      if (int(_local.size()) != P || _ranksPerNode <= 0)
+        return false;
+
+      const int N = nodes();
+      double bestBalance = 1E100, bestNodeSurface = 1E100, bestSurface = 1E100;
+      forEachFactorization(N, [&](const iTupel& nd)
+      {
+        // node blocks, to be split further among the ranks of each node
+        iTupel nodeSize;
+        for (int i=0; i<d; i++)
+          nodeSize[i] = std::max(size[i]/nd[i], 1);
+        const double nodeSurface = surface(size, nd);
+
+        forEachFactorization(_ranksPerNode, [&](const iTupel& rd)
+        {
+          iTupel trydims;
+          for (int i=0; i<d; i++)
+            trydims[i] = nd[i]*rd[i];
+
+          const double b = balance(size, trydims);
+          const double s = surface(nodeSize, rd);
+          if (b < bestBalance - 1e-10
+              || (b < bestBalance + 1e-10 && (nodeSurface < bestNodeSurface
+                                              || (nodeSurface == bestNodeSurface && s < bestSurface))))
+          {
+            bestBalance = b;
+            bestNodeSurface = nodeSurface;
+            bestSurface = s;
+            dims = trydims;
+            nodeDims = nd;
+          }
+        });
+      });
+      return true;
+    }
+
+    std::vector<int> _node;   // node number of each rank
+    std::vector<int> _local;  // number of each rank within its node
+    int _ranksPerNode = 0;
+
+    // split of the torus chosen by the last call to loadbalance()
+    mutable iTupel _dims = {};
+    mutable iTupel _nodeDims = {};
+  };
+
 }
 
 #endif
@@ -6,8 +6,13 @@
 #include <array>
 #include <bitset>
 #include <cmath>
+#include <algorithm>
+#include <cstring>
 #include <deque>
 #include <iostream>
+#include <memory>
+#include <numeric>
+#include <utility>
 #include <vector>
 
 #if HAVE_MPI
@@ -39,6 +44,12 @@ namespace Dune
 
      - Provide means to partition a grid to the torus.
 
+     The exchange of messages is done by point-to-point communication by default.
+     With MPI-3 the messages can alternatively be exchanged by a single neighborhood
+     collective on a distributed graph communicator, see useNeighborCollectives(),
+     and the messages to processes on the same node can be passed through a
+     shared-memory window, see useSharedMemory().
+
    */
   template<class CollectiveCommunication, int d>
   class Torus {
@@ -90,6 +101,38 @@ namespace Dune
       if (inc != _comm.size())
         DUNE_THROW(Dune::Exception, "Communicator size and result of the given load balancer do not match!");
 
+      // the load balancer may choose unequal extents
+      _size = size;
+      lb->cuts(size, _dims, _cuts);
+      for (int i=0; i<d; i++)
+      {
+        if (_cuts[i].empty())
+          continue;
+        if (int(_cuts[i].size()) != _dims[i]+1 || _cuts[i].front() != 0 || _cuts[i].back() != size[i])
+          DUNE_THROW(Dune::Exception, "Cut positions given by the load balancer do not match the torus!");
+        for (int j=0; j<_dims[i]; j++)
+          if (_cuts[i][j] >= _cuts[i][j+1])
+            DUNE_THROW(Dune::Exception, "Cut positions given by the load balancer are not increasing!");
+      }
+
+      // the load balancer may place the ranks differently than lexicographically
+      lb->rankCoordinates(_dims, _comm.size(), _coords);
+      if (!_coords.empty())
+      {
+        if (int(_coords.size()) != _comm.size())
+          DUNE_THROW(Dune::Exception, "Number of rank coordinates given by the load balancer does not match the communicator size!");
+        _ranks.assign(_comm.size(), -1);
+        for (int r=0; r<_comm.size(); r++)
+        {
+          if (!inside(_coords[r]))
+            DUNE_THROW(Dune::Exception, "Rank coordinate given by the load balancer is outside the torus!");
+          int& rank = _ranks[lexicographic(_coords[r])];
+          if (rank >= 0)
+            DUNE_THROW(Dune::Exception, "Load balancer assigned the same torus coordinate to several ranks!");
+          rank = r;
+        }
+      }
+
       // make full schedule
       proclists();
     }
@@ -136,6 +179,100 @@ namespace Dune
       return _tag;
     }
 
+    /** \brief choose how messages are exchanged with neighboring processes
+     *
+     * If enabled, a distributed graph communicator connecting each process with its
+     * torus neighbors is created once, and exchange() packs all messages for each
+     * neighbor into one block that is transferred by MPI_Neighbor_alltoallv.
+     * This requires MPI-3; otherwise the call is ignored and point-to-point
+     * communication is used.
+     *
+     * \note This method is collective on the communicator of the torus.
+     */
+    void useNeighborCollectives (bool enable)
+    {
+#if HAVE_MPI && MPI_VERSION >= 3
+      if (!enable)
+      {
+        _neighborComm.reset();
+        return;
+      }
+      if (_neighborComm)
+        return;
+
+      // the distinct neighbors; the torus neighborhood is symmetric
+      _neighborRanks.clear();
+      for (const CommPartner& cp : _sendlist)
+        if (cp.rank != rank())
+          _neighborRanks.push_back(cp.rank);
+      std::sort(_neighborRanks.begin(), _neighborRanks.end());
+      _neighborRanks.erase(std::unique(_neighborRanks.begin(), _neighborRanks.end()), _neighborRanks.end());
+
+      MPI_Comm graph;
+      MPI_Dist_graph_create_adjacent(_comm, _neighborRanks.size(), _neighborRanks.data(), MPI_UNWEIGHTED,
+                                     _neighborRanks.size(), _neighborRanks.data(), MPI_UNWEIGHTED,
+                                     MPI_INFO_NULL, 0, &graph);
+      _neighborComm = std::shared_ptr<MPI_Comm>(new MPI_Comm(graph), [](MPI_Comm* c)
+      {
+        int finalized;
+        MPI_Finalized(&finalized);
+        if (!finalized)
+          MPI_Comm_free(c);
+        delete c;
+      });
+#endif
+    }
+
+    //! return true if neighborhood collectives are used to exchange messages
+    bool usesNeighborCollectives () const
+    {
+#if HAVE_MPI && MPI_VERSION >= 3
+      return bool(_neighborComm);
+#else
+      return false;
+#endif
+    }
+
+    /** \brief choose whether messages to processes on the same node are passed through shared memory
+     *
+     * If enabled, the processes of the torus that share a node (MPI_COMM_TYPE_SHARED)
+     * allocate a window with MPI_Win_allocate_shared.  exchange() packs the messages
+     * for neighbors on the same node into the own segment of the window, and the
+     * neighbors copy them out directly instead of receiving MPI messages.  Messages
+     * to other nodes are exchanged as before, by point-to-point communication or by
+     * the neighborhood collective.  This requires MPI-3; otherwise the call is ignored.
+     *
+     * \note This method is collective on the communicator of the torus.  While
+     *       shared memory is used, exchange() synchronizes all processes of a
+     *       node, so all of them have to call it together.  Disabling frees the
+     *       window with the collective MPI_Win_free, also for the copies of the
+     *       torus.  Otherwise the window is freed when the last copy of the torus
+     *       is destroyed, which the processes of a node then have to do together.
+     */
+    void useSharedMemory (bool enable)
+    {
+#if HAVE_MPI && MPI_VERSION >= 3
+      if (!enable)
+      {
+        if (_shared)
+          _shared->free();
+        _shared.reset();
+      }
+      else if (!usesSharedMemory())
+        _shared = std::make_shared<SharedWindow>(_comm);
+#endif
+    }
+
+    //! return true if messages to processes on the same node are passed through shared memory
+    bool usesSharedMemory () const
+    {
+#if HAVE_MPI && MPI_VERSION >= 3
+      return _shared && !_shared->freed();
+#else
+      return false;
+#endif
+    }
+
     //! return true if coordinate is inside torus
     bool inside (iTupel c) const
     {
@@ -144,11 +281,13 @@ namespace Dune
       return true;
     }
 
-    //! map rank to coordinate in torus using lexicographic ordering
+    //! map rank to coordinate in torus (lexicographic ordering unless given by the load balancer)
     iTupel rank_to_coord (int rank) const
     {
       iTupel coord;
       rank = rank%_comm.size();
+      if (!_coords.empty())
+        return _coords[rank];
       for (int i=d-1; i>=0; i--)
       {
         coord[i] = rank/_increment[i];
@@ -157,13 +296,12 @@ namespace Dune
       return coord;
     }
 
-    //! map coordinate in torus to rank using lexicographic ordering
+    //! map coordinate in torus to rank (lexicographic ordering unless given by the load balancer)
     int coord_to_rank (iTupel coord) const
     {
       for (int i=0; i<d; i++) coord[i] = coord[i]%_dims[i];
-      int rank = 0;
-      for (int i=0; i<d; i++) rank += coord[i]*_increment[i];
-      return rank;
+      const int rank = lexicographic(coord);
+      return _ranks.empty() ? rank : _ranks[rank];
     }
 
     //! return rank of process where its coordinate in direction dir has offset cnt (handles periodic case)
@@ -249,12 +387,21 @@ namespace Dune
       // make a tensor product partition
       for (int i=0; i<d; i++)
       {
+        sz *= size_in[i];
+
+        // cut positions given by the load balancer
+        if (!_cuts[i].empty() && size_in[i] == _size[i])
+        {
+          origin_out[i] = origin_in[i] + _cuts[i][coord[i]];
+          size_out[i] = _cuts[i][coord[i]+1] - _cuts[i][coord[i]];
+          maxsize *= size_out[i];
+          continue;
+        }
+
         // determine
         int m = size_in[i]/_dims[i];
         int r = size_in[i]%_dims[i];
 
-        sz *= size_in[i];
-
         if (coord[i]<_dims[i]-r)
         {
           origin_out[i] = origin_in[i] + coord[i]*m;
@@ -409,6 +556,17 @@ namespace Dune
       _localrecvrequests.clear();
 
 #if HAVE_MPI
+#if MPI_VERSION >= 3
+      if (usesSharedMemory())
+        exchangeSharedMemory();
+
+      if (_neighborComm)
+      {
+        exchangeNeighborCollective();
+        return;
+      }
+#endif
+
       // handle foreign requests
       int sends=0;
       int recvs=0;
@@ -506,6 +664,226 @@ namespace Dune
 
   private:
 
+#if HAVE_MPI && MPI_VERSION >= 3
+    // a shared-memory window with one segment per process of a node; the
+    // constructor, allocate(), free() and thus the destructor are collective on the node
+    struct SharedWindow
+    {
+      explicit SharedWindow (MPI_Comm comm)
+      {
+        MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &nodeComm);
+        int nodeSize;
+        MPI_Comm_size(nodeComm, &nodeSize);
+        MPI_Comm_rank(nodeComm, &nodeRank);
+
+        // the ranks of the processes on the node in the torus
+        MPI_Group nodeGroup, group;
+        MPI_Comm_group(nodeComm, &nodeGroup);
+        MPI_Comm_group(comm, &group);
+        std::vector<int> local(nodeSize), global(nodeSize);
+        std::iota(local.begin(), local.end(), 0);
+        MPI_Group_translate_ranks(nodeGroup, nodeSize, local.data(), group, global.data());
+        MPI_Group_free(&nodeGroup);
+        MPI_Group_free(&group);
+        for (int q=0; q<nodeSize; q++)
+          ranks.emplace_back(global[q], q);
+        std::sort(ranks.begin(), ranks.end());
+
+        segments.resize(nodeSize, nullptr);
+        allocate(headerSize());
+      }
+
+      SharedWindow (const SharedWindow&) = delete;
+      SharedWindow& operator= (const SharedWindow&) = delete;
+
+      ~SharedWindow ()
+      {
+        int finalized;
+        MPI_Finalized(&finalized);
+        if (!finalized)
+          free();
+      }
+
+      // free the window and the node communicator, unless this was done before
+      void free ()
+      {
+        if (freed())
+          return;
+        MPI_Win_unlock_all(win);
+        MPI_Win_free(&win);
+        MPI_Comm_free(&nodeComm);
+        capacity = 0;
+      }
+
+      bool freed () const
+      {
+        return nodeComm == MPI_COMM_NULL;
+      }
+
+      // (re)allocate the window with the given segment size; collective on the node
+      void allocate (MPI_Aint size)
+      {
+        if (capacity > 0)
+        {
+          MPI_Win_unlock_all(win);
+          MPI_Win_free(&win);
+        }
+        char* base;
+        MPI_Win_allocate_shared(size, 1, MPI_INFO_NULL, nodeComm, &base, &win);
+        MPI_Win_lock_all(MPI_MODE_NOCHECK, win);
+        for (std::size_t q=0; q<segments.size(); q++)
+        {
+          MPI_Aint segmentSize;
+          int dispUnit;
+          MPI_Win_shared_query(win, q, &segmentSize, &dispUnit, &segments[q]);
+        }
+        capacity = size;
+      }
+
+      // rank on the node of a rank of the torus, -1 if it is on another node
+      int nodeRankOf (int rank) const
+      {
+        auto it = std::lower_bound(ranks.begin(), ranks.end(), std::make_pair(rank, 0));
+        return (it != ranks.end() && it->first == rank) ? it->second : -1;
+      }
+
+      // each segment starts with the offsets of the messages for each process on the node
+      MPI_Aint headerSize () const
+      {
+        return (segments.size()+1)*sizeof(MPI_Aint);
+      }
+
+      MPI_Comm nodeComm = MPI_COMM_NULL;
+      MPI_Win win;
+      int nodeRank;
+      std::vector<std::pair<int, int> > ranks; // (rank in the torus, rank on the node), sorted
+      std::vector<char*> segments;             // segment of each process on the node
+      MPI_Aint capacity = 0;                   // size of each segment in bytes
+    };
+
+    // pass the requests to processes on the same node through the shared window
+    // and remove them from the request lists
+    void exchangeSharedMemory () const
+    {
+      SharedWindow& shared = *_shared;
+      const int nodeSize = shared.segments.size();
+      const MPI_Aint header = shared.headerSize();
+
+      // the offsets are MPI_Aint such that the messages may take more than 2 GiB
+      std::vector<MPI_Aint> offsets(nodeSize+1, 0);
+      for (const CommTask& task : _sendrequests)
+      {
+        const int q = shared.nodeRankOf(task.rank);
+        if (q >= 0)
+          offsets[q+1] += task.size;
+      }
+      std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+      // all segments have the same size; this also waits until all processes
+      // of the node have read the messages of the previous exchange
+      MPI_Aint required = header + offsets[nodeSize];
+      MPI_Aint maxRequired;
+      MPI_Allreduce(&required, &maxRequired, 1, MPI_AINT, MPI_MAX, shared.nodeComm);
+      if (maxRequired > shared.capacity)
+        shared.allocate(std::max(maxRequired, 2*shared.capacity));
+
+      // pack messages to the same process in the order they were posted
+      char* segment = shared.segments[shared.nodeRank];
+      std::memcpy(segment, offsets.data(), header);
+      std::vector<MPI_Aint> pos(offsets.begin(), offsets.end()-1);
+      for (const CommTask& task : _sendrequests)
+      {
+        const int q = shared.nodeRankOf(task.rank);
+        if (q < 0)
+          continue;
+        std::memcpy(segment+header+pos[q], task.buffer, task.size);
+        pos[q] += task.size;
+      }
+
+      MPI_Win_sync(shared.win);
+      MPI_Barrier(shared.nodeComm);
+      MPI_Win_sync(shared.win);
+
+      // copy out of the segments of the senders in the order the receives were posted
+      pos.assign(nodeSize, -1);
+      for (const CommTask& task : _recvrequests)
+      {
+        const int q = shared.nodeRankOf(task.rank);
+        if (q < 0)
+          continue;
+        // the segments need not be aligned for MPI_Aint, so the offsets are copied
+        const char* sender = shared.segments[q];
+        MPI_Aint senderOffsets[2];
+        std::memcpy(senderOffsets, sender + shared.nodeRank*sizeof(MPI_Aint), sizeof(senderOffsets));
+        MPI_Aint& p = pos[q];
+        if (p < 0)
+          p = senderOffsets[0];
+        if (p+task.size > senderOffsets[1])
+          DUNE_THROW(Dune::Exception, "Torus: receives from rank " << task.rank << " do not match its sends");
+        std::memcpy(task.buffer, sender+header+p, task.size);
+        p += task.size;
+      }
+
+      auto onNode = [&shared] (const CommTask& task) { return shared.nodeRankOf(task.rank) >= 0; };
+      _sendrequests.erase(std::remove_if(_sendrequests.begin(), _sendrequests.end(), onNode), _sendrequests.end());
+      _recvrequests.erase(std::remove_if(_recvrequests.begin(), _recvrequests.end(), onNode), _recvrequests.end());
+    }
+
+    // return the position of a rank in the neighbor list of the graph communicator
+    int neighborIndex (int rank) const
+    {
+      auto it = std::lower_bound(_neighborRanks.begin(), _neighborRanks.end(), rank);
+      if (it == _neighborRanks.end() || *it != rank)
+        DUNE_THROW(Dune::Exception, "Torus: rank " << rank << " is not a neighbor of rank " << this->rank());
+      return it - _neighborRanks.begin();
+    }
+
+    // exchange all foreign requests with one neighborhood collective
+    void exchangeNeighborCollective () const
+    {
+      const int n = _neighborRanks.size();
+      std::vector<int> sendcounts(n, 0), recvcounts(n, 0);
+      std::vector<int> sdispls(n+1, 0), rdispls(n+1, 0);
+
+      for (const CommTask& task : _sendrequests)
+        sendcounts[neighborIndex(task.rank)] += task.size;
+      for (const CommTask& task : _recvrequests)
+        recvcounts[neighborIndex(task.rank)] += task.size;
+      for (int i=0; i<n; i++)
+      {
+        sdispls[i+1] = sdispls[i] + sendcounts[i];
+        rdispls[i+1] = rdispls[i] + recvcounts[i];
+      }
+
+      // pack messages to the same neighbor in the order they were posted
+      _sendbuffer.resize(sdispls[n]);
+      _recvbuffer.resize(rdispls[n]);
+      std::vector<int> pos(sdispls.begin(), sdispls.end()-1);
+      for (const CommTask& task : _sendrequests)
+      {
+        int& p = pos[neighborIndex(task.rank)];
+        std::memcpy(_sendbuffer.data()+p, task.buffer, task.size);
+        p += task.size;
+      }
+
+      MPI_Neighbor_alltoallv(_sendbuffer.data(), sendcounts.data(), sdispls.data(), MPI_BYTE,
+                             _recvbuffer.data(), recvcounts.data(), rdispls.data(), MPI_BYTE,
+                             *_neighborComm);
+
+      // unpack in the order the receives were posted
+      pos.assign(rdispls.begin(), rdispls.end()-1);
+      for (const CommTask& task : _recvrequests)
+      {
+        int& p = pos[neighborIndex(task.rank)];
+        std::memcpy(task.buffer, _recvbuffer.data()+p, task.size);
+        p += task.size;
+      }
+
+      _sendrequests.clear();
+      _recvrequests.clear();
+    }
+#endif
+
     void proclists ()
     {
       // compile the full neighbor list
@@ -558,10 +936,22 @@ namespace Dune
 
     }
 
+    //! lexicographic number of a coordinate inside the torus
+    int lexicographic (const iTupel& coord) const
+    {
+      int n = 0;
+      for (int i=0; i<d; i++) n += coord[i]*_increment[i];
+      return n;
+    }
+
     CollectiveCommunication _comm;
 
     iTupel _dims;
     iTupel _increment;
+    iTupel _size;                          // global size the cuts refer to
+    std::array<std::vector<int>, d> _cuts; // cut positions per direction, empty for equal slabs
+    std::vector<iTupel> _coords;  // coordinate of each rank, empty for lexicographic placement
+    std::vector<int> _ranks;      // rank at each lexicographic position, empty for lexicographic placement
     int _tag;
     std::deque<CommPartner> _sendlist;
     std::deque<CommPartner> _recvlist;
@@ -571,6 +961,16 @@ namespace Dune
     mutable std::vector<CommTask> _localsendrequests;
     mutable std::vector<CommTask> _localrecvrequests;
 
+#if HAVE_MPI && MPI_VERSION >= 3
+    // graph communicator for neighborhood collectives, shared between copies of the torus
+    std::shared_ptr<MPI_Comm> _neighborComm;
+    std::vector<int> _neighborRanks;
+    mutable std::vector<char> _sendbuffer;
+    mutable std::vector<char> _recvbuffer;
+    // shared-memory window of the processes on this node, shared between copies of the torus
+    std::shared_ptr<SharedWindow> _shared;
+#endif
+
   };
 
   //! Output operator for Torus
@@ -0,0 +1,207 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_YASPGRIDBOXVIEW_HH
+#define DUNE_GRID_YASPGRIDBOXVIEW_HH
+
+#include <array>
+#include <bitset>
+#include <cassert>
+#include <type_traits>
+#include <utility>
+
+#include <dune/common/exceptions.hh>
+#include <dune/grid/common/gridenums.hh>
+#include <dune/grid/common/exceptions.hh>
+#include "../yaspgrid.hh"
+
+/** \file
+ * \brief Structured (box) access to the entities of a YaspGrid level
+ *
+ * The index sets of YaspGrid number the entities of each codimension
+ * lexicographically, one YGridComponent (box) after the other.  A
+ * YaspBoxView exposes these boxes together with the strides of this
+ * numbering, such that data stored in index set (or mapper) order can
+ * be processed by plain nested loops instead of entity iterators.
+ */
+
+namespace Dune {
+
+  /** \brief Structured view onto the index numbering of one YaspGrid level
+   *
+   * For each codimension the entities of a YaspGrid level are grouped into
+   * \f$\binom{d}{c}\f$ boxes, one for each combination of directions the
+   * entities extend into (the shift of the box).  Within the box of shift
+   * number \c which, the index of the entity with coordinate \f$k\f$ is
+   * \f[ \mathrm{offset}(c,w) + \sum_i (k_i - o_i)\,\mathrm{stride}_i(c,w) \f]
+   * where \f$o\f$ is the origin of the full (All_Partition) box.
+   * The index coincides with the one returned by the level or leaf index set
+   * of the corresponding grid view.
+   *
+   * The partition boxes (interior, interior+border, overlap) are sub boxes
+   * of the full box and share its strides.  YaspGrid has no ghost entities,
+   * hence the ghost box is always empty.
+   *
+   * \code
+   * auto bv = yaspBoxView(grid.leafGridView());
+   * const auto& box = bv.box(0, 0, Interior_Partition);
+   * auto stride = bv.strides(0, 0);
+   * for (int k=0; k<box.size(2); ++k)
+   *   for (int j=0; j<box.size(1); ++j)
+   *   {
+   *     int idx = bv.index(0, 0, box.origin()) + j*stride[1] + k*stride[2];
+   *     for (int i=0; i<box.size(0); ++i, ++idx)
+   *       y[idx] = ...;
+   *   }
+   * \endcode
+   *
+   * \tparam GridImp The (const) YaspGrid type
+   */
+  template<class GridImp>
+  class YaspBoxView
+  {
+    typedef typename std::remove_const<GridImp>::type Grid;
+
+  public:
+    //! dimension of the grid
+    static const int dimension = Grid::dimension;
+
+    //! the coordinate container type of the grid
+    typedef std::decay_t<decltype(std::declval<typename Grid::YGridLevel>().coords)> Coordinates;
+
+    //! type of a box of entities
+    typedef YGridComponent<Coordinates> Box;
+
+    //! type used for coordinate tuples and strides
+    typedef std::array<int, dimension> iTupel;
+
+    /** \brief construct a box view for a given grid level
+     *
+     * \param g iterator pointing to the grid level
+     */
+    explicit YaspBoxView (typename Grid::YGridLevelIterator g)
+      : _g(g)
+    {}
+
+    //! level this view refers to
+    int level () const
+    {
+      return _g->level();
+    }
+
+    //! number of entities of given codimension, equals indexSet().size(codim)
+    int size (int codim) const
+    {
+      int count = 0;
+      for (auto it = _g->overlapfront[codim].dataBegin(); it != _g->overlapfront[codim].dataEnd(); ++it)
+        count += it->totalsize();
+      return count;
+    }
+
+    //! number of boxes the entities of given codimension are grouped into
+    int boxes (int codim) const
+    {
+      return _g->overlapfront[codim].dataEnd() - _g->overlapfront[codim].dataBegin();
+    }
+
+    /** \brief return a box of entities
+     *
+     * \param codim  codimension of the entities
+     * \param which  number of the box within the codimension, 0 <= which < boxes(codim)
+     * \param pitype partition the box is restricted to
+     */
+    const Box& box (int codim, int which, PartitionIteratorType pitype = All_Partition) const
+    {
+      assert(0 <= which && which < boxes(codim));
+
+      switch (pitype)
+      {
+      case Interior_Partition :
+        return *(_g->interior[codim].dataBegin() + which);
+      case InteriorBorder_Partition :
+        return *(_g->interiorborder[codim].dataBegin() + which);
+      case Overlap_Partition :
+        return *(_g->overlap[codim].dataBegin() + which);
+      case OverlapFront_Partition :
+      case All_Partition :
+        return *(_g->overlapfront[codim].dataBegin() + which);
+      case Ghost_Partition :
+        return emptyBox();
+      }
+      DUNE_THROW(GridError, "YaspBoxView: unknown partition type");
+    }
+
+    //! directions the entities of the given box extend into
+    const std::bitset<dimension>& shift (int codim, int which) const
+    {
+      return box(codim, which).shift();
+    }
+
+    //! index of the first entity of the given box in the All_Partition numbering
+    int offset (int codim, int which) const
+    {
+      const Box& b = box(codim, which);
+      return _g->overlapfront[codim].superindex(b.origin(), which);
+    }
+
+    //! strides of the index numbering within the given box, stride[0] is always 1
+    iTupel strides (int codim, int which) const
+    {
+      const Box& b = box(codim, which);
+      iTupel s;
+      for (int i=0; i<dimension; ++i)
+        s[i] = b.superincrement(i);
+      return s;
+    }
+
+    //! index of the entity with the given (global) coordinate within the given box
+    int index (int codim, int which, const iTupel& coord) const
+    {
+      return _g->overlapfront[codim].superindex(coord, which);
+    }
+
+    //! number of the box containing entities with the given shift
+    int which (int codim, const std::bitset<dimension>& shift) const
+    {
+      return _g->overlapfront[codim].shiftmapping(shift);
+    }
+
+  private:
+    static const Box& emptyBox ()
+    {
+      static const Box empty;
+      return empty;
+    }
+
+    typename Grid::YGridLevelIterator _g;
+  };
+
+  /** \brief return the box view of a level of a YaspGrid
+   * \relates YaspBoxView
+   */
+  template<int dim, class Coordinates>
+  YaspBoxView<const YaspGrid<dim, Coordinates> >
+  yaspBoxView (const YaspGrid<dim, Coordinates>& grid, int level)
+  {
+    return YaspBoxView<const YaspGrid<dim, Coordinates> >(grid.begin(level));
+  }
+
+  /** \brief return the box view of the grid level underlying a YaspGrid grid view
+   *
+   * Works for leaf as well as level grid views.
+   * \relates YaspBoxView
+   */
+  template<class GridView>
+  YaspBoxView<const typename GridView::Grid> yaspBoxView (const GridView& gridView)
+  {
+    const auto& grid = gridView.grid();
+    for (int level = 0; level < grid.maxLevel(); ++level)
+      if (&gridView.indexSet() == &grid.levelIndexSet(level))
+        return yaspBoxView(grid, level);
+
+    // the leaf index set and the finest level index set are numbering the same entities
+    return yaspBoxView(grid, grid.maxLevel());
+  }
+
+} // namespace Dune
+
+#endif // DUNE_GRID_YASPGRIDBOXVIEW_HH
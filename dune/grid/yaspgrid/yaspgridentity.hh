@@ -779,6 +779,36 @@ namespace Dune {
       return _g->overlapfront[cc].superindex(coord,which);
     }
 
+    //! compressed indices of all subentities of codimension cc
+    template<class SubIndices>
+    void subCompressedIndices (int cc, SubIndices& result) const
+    {
+      const auto& ygrid = _g->overlapfront[cc];
+      const std::array<int, dim> coord = _it.coord();
+
+      // the subentities with the same shift live in the same component, their
+      // indices differ from the index of the cell only by the moves
+      std::array<int, StaticPower<2,dim>::power> cellIndex;
+      cellIndex.fill(-1);
+
+      const int size = Dune::Yasp::subEnt<dim>(dim,cc);
+      result.resize(size);
+      for (int i=0; i<size; i++)
+      {
+        const int which = ygrid.shiftmapping(Dune::Yasp::entityShift<dim>(i,cc));
+        if (cellIndex[which] < 0)
+          cellIndex[which] = ygrid.superindex(coord,which);
+
+        const std::bitset<dim> move = Dune::Yasp::entityMove<dim>(i,cc);
+        const auto& component = *(ygrid.dataBegin()+which);
+        int index = cellIndex[which];
+        for (int j=0; j<dim; j++)
+          if (move[j])
+            index += component.superincrement(j);
+        result[i] = index;
+      }
+    }
+
     I _it;         // position in the grid level
     YGLI _g;         // access to grid level
   };
@@ -7,9 +7,15 @@
  * \brief The YaspEntitySeed class
  */
 
+#include <array>
+#include <cstdint>
+
 namespace Dune {
 
   /** \brief Describes the minimal information necessary to create a fully functional YaspEntity
+   *
+   * The seed is trivially copyable.  The level and the offset share four
+   * bytes, such that a seed takes (dim+1)*sizeof(int) bytes.
    */
   template<int codim, class GridImp>
   class YaspEntitySeed
@@ -17,6 +23,8 @@ namespace Dune {
     //! know your own dimension
     enum { dim=GridImp::dimension };
 
+    static_assert(dim < 16, "The offset of a YaspEntitySeed has only 16 bits");
+
   public:
     //! codimension of entity pointer
     enum { codimension = codim };
@@ -25,17 +33,12 @@ namespace Dune {
     YaspEntitySeed ()
       : _l(-1), _o(0)
     {
-      std::fill(_c.begin(),_c.end(),0);
+      _c.fill(0);
     }
 
     //! constructor
     YaspEntitySeed (int level, std::array<int, dim> coord, int o = 0)
-      : _l(level), _c(coord), _o(o)
-    {}
-
-    //! copy constructor
-    YaspEntitySeed (const YaspEntitySeed& rhs)
-      : _l(rhs._l), _c(rhs._c), _o(rhs._o)
+      : _l(level), _o(o), _c(coord)
     {}
 
     //! check whether the EntitySeed refers to a valid Entity
@@ -49,9 +52,9 @@ namespace Dune {
     int offset () const { return _o; }
 
   protected:
-    int _l;                  // grid level
+    std::int16_t _l;         // grid level
+    std::uint16_t _o;        // the offset: which YGridComponent, does the entity belong to
     std::array<int, dim> _c; // coord in the global grid
-    int _o; // the offset: which YGridComponent, does the entity belong to
   };
 
 }  // namespace Dune
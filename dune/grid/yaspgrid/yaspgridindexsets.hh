@@ -67,6 +67,17 @@ namespace Dune {
       return e.impl().subCompressedIndex(i, codim);
     }
 
+    //! get indices of all subentities of an element of the given codimension
+    template< int cc >
+    std::enable_if_t< cc == 0, typename Base::SubIndices >
+    subIndices ( const typename std::remove_const< GridImp >::type::Traits::template Codim< cc >::Entity &e,
+                 unsigned int codim ) const
+    {
+      typename Base::SubIndices result;
+      e.impl().subCompressedIndices(codim, result);
+      return result;
+    }
+
     //! get number of entities of given type and level (the level is known to the object)
     int size (GeometryType type) const
     {
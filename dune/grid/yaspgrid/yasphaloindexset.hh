@@ -0,0 +1,376 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_YASPHALOINDEXSET_HH
+#define DUNE_GRID_YASPHALOINDEXSET_HH
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cassert>
+#include <type_traits>
+#include <vector>
+
+#include <dune/geometry/type.hh>
+#include <dune/grid/common/exceptions.hh>
+#include <dune/grid/common/indexidset.hh>
+#include "../yaspgrid.hh"
+
+/** \file
+ * \brief An index set for YaspGrid that groups the entities by owner
+ *
+ * The entities are numbered such that the entities owned by this process come
+ * first (interior before border), followed by one contiguous block of
+ * non-owned entities per neighbor process.  Halo data can then be received
+ * directly into place.
+ */
+
+namespace Dune {
+
+  /** \brief Index set for a YaspGrid level with owned entities first and
+   *         halo entities stored contiguously per neighbor process
+   *
+   * Each entity of the overlap-extended subdomain has exactly one owner: the
+   * process whose interior cell range contains the lower left coordinate of
+   * the entity (entities on the upper end of a non-periodic domain belong to
+   * the last process in that direction).  The entities of each codimension are
+   * numbered as
+   *
+   * - <tt>[0, interiorSize(codim))</tt>: owned interior entities,
+   * - <tt>[interiorSize(codim), ownedSize(codim))</tt>: owned border entities,
+   * - <tt>[ownedSize(codim), size(codim))</tt>: non-owned entities, one block per
+   *   neighbor process (and periodic image of it), see recvBlocks().
+   *
+   * This is the layout used by PETSc or hypre for distributed vectors.
+   * Within each block the entities are ordered lexicographically.
+   * The matching send side is described by sendBlocks() and sendIndices(), and
+   * exchange() copies the values of owned entities into the halo blocks of all
+   * neighbors with one message per block.
+   *
+   * \tparam GridImp The (const) YaspGrid type
+   */
+  template<class GridImp>
+  class YaspHaloIndexSet
+    : public IndexSet< GridImp, YaspHaloIndexSet< GridImp >, unsigned int >
+  {
+    typedef YaspHaloIndexSet< GridImp > This;
+    typedef IndexSet< GridImp, This, unsigned int > Base;
+    typedef typename std::remove_const<GridImp>::type Grid;
+
+    static const int dim = Grid::dimension;
+
+    typedef typename Grid::YGridLevelIterator YGLI;
+    typedef std::decay_t<decltype(std::declval<typename Grid::YGridLevel>().coords)> Coordinates;
+    typedef YGridComponent<Coordinates> Box;
+    typedef std::array<int, dim> iTupel;
+
+  public:
+    typedef typename Base::IndexType IndexType;
+
+    //! a contiguous block of indices exchanged with one neighbor process
+    struct Block
+    {
+      //! rank of the neighbor process
+      int rank;
+      //! first index of the block
+      IndexType begin;
+      //! one past the last index of the block
+      IndexType end;
+
+      IndexType size () const { return end - begin; }
+    };
+
+    using Base::subIndex;
+
+    /** \brief construct the index set for the entities of a YaspGrid grid view
+     *
+     * Works for leaf as well as level grid views.  The index set has to be
+     * rebuilt after the grid has been refined.
+     */
+    template<class GridView>
+    explicit YaspHaloIndexSet (const GridView& gridView)
+      : grid_(gridView.grid()),
+        g_(grid_.begin(yaspBoxView(gridView).level()))
+    {
+      for (int codim=0; codim<=dim; codim++)
+        types_[codim].push_back(GeometryTypes::cube(dim-codim));
+
+      computeCuts();
+      for (int codim=0; codim<=dim; codim++)
+        renumber(codim);
+    }
+
+    //! get index of an entity
+    template<int cc>
+    IndexType index (const typename Grid::Traits::template Codim<cc>::Entity& e) const
+    {
+      return permutation_[cc][e.impl().compressedIndex()];
+    }
+
+    //! get index of subentity of an entity
+    template< int cc >
+    IndexType subIndex ( const typename Grid::Traits::template Codim< cc >::Entity &e,
+                         int i, unsigned int codim ) const
+    {
+      return permutation_[codim][e.impl().subCompressedIndex(i, codim)];
+    }
+
+    //! get number of entities of given type
+    IndexType size (GeometryType type) const
+    {
+      return type.isCube() ? size(dim-type.dim()) : 0;
+    }
+
+    //! return size of set for a given codim
+    IndexType size (int codim) const
+    {
+      return permutation_[codim].size();
+    }
+
+    //! number of owned entities in the interior partition
+    IndexType interiorSize (int codim) const
+    {
+      return interiorSize_[codim];
+    }
+
+    //! number of owned entities, these carry the indices 0 to ownedSize(codim)-1
+    IndexType ownedSize (int codim) const
+    {
+      return ownedSize_[codim];
+    }
+
+    //! return true if the given entity is owned by this process
+    template<class Entity>
+    bool owns (const Entity& e) const
+    {
+      return Base::index(e) < ownedSize(Entity::codimension);
+    }
+
+    //! return true if the given entity is contained in the index set
+    template<class EntityType>
+    bool contains (const EntityType& e) const
+    {
+      return e.level() == g_->level();
+    }
+
+    std::vector< GeometryType > types ( int codim ) const { return types_[ codim ]; }
+
+    //! deliver all geometry types used in this grid
+    const std::vector<GeometryType>& geomTypes (int codim) const
+    {
+      return types_[codim];
+    }
+
+    //! blocks of non-owned entities, in the order they are received
+    const std::vector<Block>& recvBlocks (int codim) const
+    {
+      return recvBlocks_[codim];
+    }
+
+    //! blocks of owned entities to be sent, ranges into sendIndices()
+    const std::vector<Block>& sendBlocks (int codim) const
+    {
+      return sendBlocks_[codim];
+    }
+
+    //! indices of the owned entities to be sent, in message order
+    const std::vector<IndexType>& sendIndices (int codim) const
+    {
+      return sendIndices_[codim];
+    }
+
+    /** \brief copy the values of owned entities into the halo of all neighbors
+     *
+     * The values of each send block are packed into one buffer, the halo blocks
+     * are received directly into \p data.
+     *
+     * \param data  vector with one entry of trivially copyable type per entity,
+     *              stored in the order of this index set
+     * \param codim codimension the data is attached to
+     */
+    template<class V>
+    void exchange (V& data, int codim) const
+    {
+      typedef typename V::value_type T;
+      static_assert(std::is_trivially_copyable<T>::value,
+                    "YaspHaloIndexSet::exchange requires trivially copyable data");
+      assert(data.size() == size(codim));
+
+      const auto& torus = grid_.torus();
+
+      std::vector<T> buffer(sendIndices_[codim].size());
+      for (std::size_t i=0; i<buffer.size(); ++i)
+        buffer[i] = data[sendIndices_[codim][i]];
+
+      for (const auto& block : sendBlocks_[codim])
+        torus.send(block.rank, buffer.data() + block.begin, block.size()*sizeof(T));
+      for (const auto& block : recvBlocks_[codim])
+        torus.recv(block.rank, &data[0] + block.begin, block.size()*sizeof(T));
+
+      torus.exchange();
+    }
+
+  private:
+
+    // store the first cell coordinate of each process for all directions
+    void computeCuts ()
+    {
+      const auto& torus = grid_.torus();
+      const int refine = 1 << g_->level();
+
+      iTupel zero;
+      std::fill(zero.begin(), zero.end(), 0);
+
+      for (int i=0; i<dim; i++)
+      {
+        cuts_[i].resize(torus.dims(i)+1);
+        for (int p=0; p<torus.dims(i); p++)
+        {
+          iTupel c(zero);
+          c[i] = p;
+          iTupel o, s;
+          torus.partition(torus.coord_to_rank(c), zero, grid_.levelSize(0), o, s);
+          cuts_[i][p] = refine * o[i];
+        }
+        cuts_[i].back() = grid_.levelSize(g_->level(), i);
+      }
+    }
+
+    // return true if the coordinate lies in the fundamental domain of periodic directions
+    bool canonical (const iTupel& coord) const
+    {
+      for (int i=0; i<dim; i++)
+        if (grid_.isPeriodic(i) && (coord[i] < 0 || coord[i] >= cuts_[i].back()))
+          return false;
+      return true;
+    }
+
+    // return the rank owning the entity with given coordinate and shift
+    int owner (iTupel coord, const std::bitset<dim>& shift) const
+    {
+      const auto& torus = grid_.torus();
+      iTupel c;
+      for (int i=0; i<dim; i++)
+      {
+        const int n = cuts_[i].back();
+        if (grid_.isPeriodic(i))
+          coord[i] = ((coord[i] % n) + n) % n;
+
+        // vertices on the upper domain boundary belong to the last process
+        if (coord[i] == n)
+        {
+          assert(!shift[i]);
+          c[i] = torus.dims(i)-1;
+          continue;
+        }
+
+        c[i] = std::upper_bound(cuts_[i].begin(), cuts_[i].end(), coord[i]) - cuts_[i].begin() - 1;
+      }
+      return torus.coord_to_rank(c);
+    }
+
+    void renumber (int codim)
+    {
+      const int rank = grid_.torus().rank();
+      const auto& overlapfront = g_->overlapfront[codim];
+
+      // count the entities of the codimension
+      IndexType n = 0;
+      for (auto it = overlapfront.dataBegin(); it != overlapfront.dataEnd(); ++it)
+        n += it->totalsize();
+
+      const IndexType unset = n;
+      std::vector<IndexType>& perm = permutation_[codim];
+      perm.assign(n, unset);
+
+      IndexType next = 0;
+
+      // Owned interior entities first, then owned border entities. Across periodic
+      // boundaries only the copy inside the fundamental domain is owned.
+      auto numberOwned = [&](const YGrid<Coordinates>& ygrid)
+      {
+        int which = 0;
+        for (auto box = ygrid.dataBegin(); box != ygrid.dataEnd(); ++box, ++which)
+          for (auto it = box->begin(); it != box->end(); ++it)
+          {
+            const int idx = overlapfront.superindex(it.coord(), which);
+            if (perm[idx] == unset && canonical(it.coord()) && owner(it.coord(), box->shift()) == rank)
+              perm[idx] = next++;
+          }
+      };
+      numberOwned(g_->interior[codim]);
+      interiorSize_[codim] = next;
+      numberOwned(g_->interiorborder[codim]);
+      ownedSize_[codim] = next;
+
+      // One block per receive intersection, holding the entities whose owned copy
+      // lives on the sending side of that intersection
+      recvBlocks_[codim].clear();
+      const auto& recvlist = g_->recv_overlapfront_interiorborder[codim];
+      for (auto is = recvlist.begin(); is != recvlist.end(); ++is)
+      {
+        Block block;
+        block.rank = is->rank;
+        block.begin = next;
+
+        const Box& box = is->grid;
+        const int which = overlapfront.shiftmapping(box.shift());
+        for (auto it = box.begin(); it != box.end(); ++it)
+        {
+          iTupel remote = it.coord();
+          for (int i=0; i<dim; i++)
+            remote[i] -= is->move[i];
+          if (owner(it.coord(), box.shift()) != is->rank || !canonical(remote))
+            continue;
+
+          const int idx = overlapfront.superindex(it.coord(), which);
+          assert(perm[idx] == unset);
+          perm[idx] = next++;
+        }
+
+        block.end = next;
+        recvBlocks_[codim].push_back(block);
+      }
+
+      if (next != n)
+        DUNE_THROW(GridError, "YaspHaloIndexSet: " << n-next << " entities of codim "
+                   << codim << " could not be assigned to an owner");
+
+      // the owned entities that neighbors receive from us, in the order they expect them
+      sendBlocks_[codim].clear();
+      sendIndices_[codim].clear();
+      const auto& sendlist = g_->send_interiorborder_overlapfront[codim];
+      for (auto is = sendlist.begin(); is != sendlist.end(); ++is)
+      {
+        Block block;
+        block.rank = is->rank;
+        block.begin = sendIndices_[codim].size();
+
+        const Box& box = is->grid;
+        const int which = overlapfront.shiftmapping(box.shift());
+        for (auto it = box.begin(); it != box.end(); ++it)
+          if (canonical(it.coord()) && owner(it.coord(), box.shift()) == rank)
+            sendIndices_[codim].push_back(perm[overlapfront.superindex(it.coord(), which)]);
+
+        block.end = sendIndices_[codim].size();
+        sendBlocks_[codim].push_back(block);
+      }
+    }
+
+    const Grid& grid_;
+    YGLI g_;
+
+    std::array<std::vector<int>, dim> cuts_;
+
+    std::array<std::vector<IndexType>, dim+1> permutation_;
+    std::array<IndexType, dim+1> interiorSize_;
+    std::array<IndexType, dim+1> ownedSize_;
+    std::array<std::vector<Block>, dim+1> recvBlocks_;
+    std::array<std::vector<Block>, dim+1> sendBlocks_;
+    std::array<std::vector<IndexType>, dim+1> sendIndices_;
+
+    std::vector<GeometryType> types_[dim+1];
+  };
+
+} // namespace Dune
+
+#endif // DUNE_GRID_YASPHALOINDEXSET_HH
@@ -831,6 +831,8 @@ namespace Dune {
       int rank;
       /** \brief Manhattan distance to the other grid */
       int distance;
+      /** \brief Translation mapping coordinates of the other process to local ones (nonzero only across periodic boundaries) */
+      std::array<int, dim> move;
       /** \brief a YGrid stub, that acts wraps above YGrid Component and handels the index offset */
       YGrid<Coordinates> yg;
     };